@@ -28,13 +28,18 @@ SPVTOOLS_SRC_FILES := \
 		source/text.cpp \
 		source/text_handler.cpp \
 		source/to_string.cpp \
+		source/validation_cache.cpp \
+		source/util/arena.cpp \
 		source/util/bit_vector.cpp \
 		source/util/parse_number.cpp \
+		source/util/perf_counters.cpp \
 		source/util/string_utils.cpp \
+		source/util/thread_pool.cpp \
 		source/util/timer.cpp \
 		source/val/basic_block.cpp \
 		source/val/construct.cpp \
 		source/val/function.cpp \
+		source/val/function_check_cache.cpp \
 		source/val/instruction.cpp \
 		source/val/validation_state.cpp \
 		source/val/validate.cpp \
@@ -71,6 +76,7 @@ SPVTOOLS_SRC_FILES := \
 		source/val/validate_logical_pointers.cpp \
 		source/val/validate_logicals.cpp \
 		source/val/validate_non_uniform.cpp \
+		source/val/validate_pass_table.cpp \
 		source/val/validate_primitives.cpp \
 		source/val/validate_ray_query.cpp \
 		source/val/validate_ray_tracing.cpp \
@@ -85,6 +91,7 @@ SPVTOOLS_SRC_FILES := \
 SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/aggressive_dead_code_elim_pass.cpp \
 		source/opt/amd_ext_to_khr.cpp \
+		source/opt/analysis_report.cpp \
 		source/opt/analyze_live_input_pass.cpp \
 		source/opt/basic_block.cpp \
 		source/opt/block_merge_pass.cpp \
@@ -167,6 +174,7 @@ SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/pass.cpp \
 		source/opt/pass_manager.cpp \
 		source/opt/private_to_local_pass.cpp \
+		source/opt/profiler.cpp \
 		source/opt/propagator.cpp \
 		source/opt/reduce_load_size.cpp \
 		source/opt/redundancy_elimination.cpp \
@@ -138,6 +138,13 @@ class SPIRV_TOOLS_EXPORT ValidatorOptions {
     spvValidatorOptionsSetAllowVulkan32BitBitwise(options_, val);
   }
 
+  // Sets the number of threads the validator may use to check functions
+  // concurrently. The diagnostic reported for an invalid module does not
+  // depend on the number of threads.
+  void SetNumThreads(uint32_t val) {
+    spvValidatorOptionsSetNumThreads(options_, val);
+  }
+
   // Records whether or not the validator should relax the rules on pointer
   // usage in logical addressing mode.
   //
@@ -174,6 +181,66 @@ class SPIRV_TOOLS_EXPORT ValidatorOptions {
   spv_validator_options options_;
 };
 
+// A store of the modules that passed validation, which lets callers skip
+// validating the same module again. Entries are keyed by a digest of the
+// module words, the target environment, the validator options and the
+// library version; see Key(). Only successful validations are recorded, so an
+// invalid module is always validated again and its diagnostic reported.
+//
+// The digest is fast rather than cryptographic: a cache must not be shared
+// with producers of modules that are not trusted. Implementations must be safe
+// to call from several threads if the cache is shared between them.
+class SPIRV_TOOLS_EXPORT ValidationCache {
+ public:
+  virtual ~ValidationCache();
+
+  // Returns true if |key| has been recorded with Insert().
+  virtual bool Contains(const std::string& key) = 0;
+
+  // Records that the module with the given |key| is valid.
+  virtual void Insert(const std::string& key) = 0;
+
+  // Returns the key of the |binary_size| words at |binary| validated for
+  // |env| with |options|. Options that do not change whether a module is
+  // valid, such as the number of threads, are not part of the key.
+  static std::string Key(spv_target_env env, spv_validator_options options,
+                         const uint32_t* binary, size_t binary_size);
+};
+
+// A validation cache that keeps up to |capacity| keys in memory, and evicts
+// the least recently used key when it is full.
+class SPIRV_TOOLS_EXPORT InMemoryValidationCache : public ValidationCache {
+ public:
+  explicit InMemoryValidationCache(size_t capacity);
+  ~InMemoryValidationCache() override;
+
+  InMemoryValidationCache(const InMemoryValidationCache&) = delete;
+  InMemoryValidationCache& operator=(const InMemoryValidationCache&) = delete;
+
+  bool Contains(const std::string& key) override;
+  void Insert(const std::string& key) override;
+
+ private:
+  struct SPIRV_TOOLS_LOCAL Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// A validation cache that records each key as a file in |directory| that is
+// named after the key and holds it, so that it persists across processes. A
+// file that does not hold its key, such as one left by an interrupted write,
+// is not an entry. The directory must exist. Entries are never evicted;
+// remove the files to clear the cache.
+class SPIRV_TOOLS_EXPORT DirectoryValidationCache : public ValidationCache {
+ public:
+  explicit DirectoryValidationCache(std::string directory);
+
+  bool Contains(const std::string& key) override;
+  void Insert(const std::string& key) override;
+
+ private:
+  std::string directory_;
+};
+
 // A C++ wrapper around an optimization options object.
 class SPIRV_TOOLS_EXPORT OptimizerOptions {
  public:
@@ -395,6 +462,12 @@ class SPIRV_TOOLS_EXPORT SpirvTools {
   // binary itself, or in the validator options.
   bool Validate(const uint32_t* binary, size_t binary_size,
                 spv_validator_options options) const;
+  // Like the previous overload, but first looks the module up in |cache|, and
+  // returns true without validating it if it is there. Otherwise validates the
+  // module, and records it in |cache| if it is valid. A null |cache| is
+  // ignored.
+  bool Validate(const uint32_t* binary, size_t binary_size,
+                spv_validator_options options, ValidationCache* cache) const;
 
   // Was this object successfully constructed.
   bool IsValid() const;
@@ -235,7 +235,29 @@ class SPIRV_TOOLS_EXPORT Optimizer {
   // |out| output stream.
   Optimizer& SetTimeReport(std::ostream* out);
 
-  // Sets the option to validate the module after each pass.
+  // Sets the option to report, for each pass, the analyses it invalidated and
+  // how often and at what cost analyses were rebuilt while it ran. The report
+  // is written after the last pass. If |out| is null, then no output is
+  // generated. Otherwise, output is sent to the |out| output stream.
+  Optimizer& SetAnalysisReport(std::ostream* out);
+
+  // Sets the option to write a JSON profile of each run to |out|: for every
+  // pass, its wall and CPU time, the growth of the peak RSS, the page faults,
+  // the hardware counters (cycles, instructions, cache and branch misses), and
+  // the number of functions, blocks and instructions before and after the
+  // pass. Memory figures and hardware counts are null where they are not
+  // available. If |out| is null, then no output is generated.
+  Optimizer& SetProfileReport(std::ostream* out);
+
+  // Sets the option to write the trace events of each run to |out| in the
+  // Chrome trace event format, which chrome://tracing and Perfetto can load.
+  // The trace covers the pass manager run, each pass, analysis builds,
+  // validation, parsing and serialization. If |out| is null, then no output
+  // is generated.
+  Optimizer& SetTraceReport(std::ostream* out);
+
+  // Sets the option to validate the module after each pass, including passes
+  // that report no change.
   Optimizer& SetValidateAfterAll(bool validate);
 
  private:
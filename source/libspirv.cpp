@@ -166,6 +166,18 @@ bool SpirvTools::Validate(const uint32_t* binary, const size_t binary_size,
   return valid;
 }
 
+bool SpirvTools::Validate(const uint32_t* binary, const size_t binary_size,
+                          spv_validator_options options,
+                          ValidationCache* cache) const {
+  if (!cache) return Validate(binary, binary_size, options);
+  const std::string key = ValidationCache::Key(impl_->context->target_env,
+                                               options, binary, binary_size);
+  if (cache->Contains(key)) return true;
+  const bool valid = Validate(binary, binary_size, options);
+  if (valid) cache->Insert(key);
+  return valid;
+}
+
 bool SpirvTools::IsValid() const { return impl_->context != nullptr; }
 
 }  // namespace spvtools
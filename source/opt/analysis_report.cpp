@@ -0,0 +1,224 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/analysis_report.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+
+#include "source/opt/profiler.h"
+
+#if defined(SPIRV_TIMER_ENABLED)
+#include <sys/resource.h>
+#endif
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// Returns the bit position of the single analysis in |analysis|.
+uint32_t AnalysisIndex(uint32_t analysis) {
+  assert(analysis != 0 && (analysis & (analysis - 1)) == 0 &&
+         "Expected exactly one analysis.");
+  uint32_t index = 0;
+  while ((analysis >>= 1) != 0) ++index;
+  assert(index < AnalysisReport::kNumAnalyses);
+  return index;
+}
+
+// Returns the number of page faults of the process so far, or -1 if it is not
+// known.
+long PageFaults() {
+#if defined(SPIRV_TIMER_ENABLED)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return usage.ru_minflt + usage.ru_majflt;
+  }
+#endif
+  return -1;
+}
+
+}  // namespace
+
+void AnalysisReport::BuildStats::Add(const BuildStats& other) {
+  count += other.count;
+  seconds += other.seconds;
+  if (page_faults < 0 || other.page_faults < 0) {
+    page_faults = -1;
+  } else {
+    page_faults += other.page_faults;
+  }
+}
+
+AnalysisReport::ScopedBuild::ScopedBuild(AnalysisReport* report,
+                                         uint32_t analysis, uint32_t count)
+    : report_(report), analysis_(analysis), count_(count) {
+  if (report_ == nullptr) return;
+  report_->nested_.emplace_back();
+  start_page_faults_ = PageFaults();
+  start_ = std::chrono::steady_clock::now();
+}
+
+AnalysisReport::ScopedBuild::~ScopedBuild() {
+  if (report_ == nullptr) return;
+  const auto end = std::chrono::steady_clock::now();
+  const long end_page_faults = PageFaults();
+
+  BuildStats total;
+  total.count = count_;
+  total.seconds = std::chrono::duration<double>(end - start_).count();
+  total.page_faults = (start_page_faults_ < 0 || end_page_faults < 0)
+                          ? -1
+                          : end_page_faults - start_page_faults_;
+
+  // Leave out what the nested scopes already recorded.
+  BuildStats own = total;
+  const BuildStats& nested = report_->nested_.back();
+  own.seconds -= nested.seconds;
+  if (own.page_faults >= 0 && nested.page_faults >= 0) {
+    own.page_faults -= nested.page_faults;
+  }
+  report_->nested_.pop_back();
+  if (!report_->nested_.empty()) {
+    BuildStats& enclosing = report_->nested_.back();
+    enclosing.seconds += total.seconds;
+    if (enclosing.page_faults >= 0) {
+      enclosing.page_faults = total.page_faults < 0
+                                  ? -1
+                                  : enclosing.page_faults + total.page_faults;
+    }
+  }
+  report_->RecordBuild(analysis_, own);
+  if (report_->profiler_ != nullptr) {
+    report_->profiler_->AddEvent(AnalysisName(AnalysisIndex(analysis_)),
+                                 "analysis", start_, end);
+  }
+}
+
+AnalysisReport::AnalysisReport() {
+  std::fill(std::begin(last_invalidator_), std::end(last_invalidator_), -1);
+}
+
+void AnalysisReport::BeginPass(const char* name) {
+  entries_.emplace_back();
+  entries_.back().pass_name = name;
+}
+
+void AnalysisReport::RecordInvalidation(uint32_t analyses) {
+  if (entries_.empty()) return;
+  entries_.back().invalidated |= analyses;
+  for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+    if (analyses & (1u << i)) {
+      last_invalidator_[i] = static_cast<int>(entries_.size() - 1);
+    }
+  }
+}
+
+void AnalysisReport::RecordBuild(uint32_t analysis, const BuildStats& stats) {
+  if (entries_.empty()) return;
+  const uint32_t index = AnalysisIndex(analysis);
+  entries_.back().builds[index].Add(stats);
+  if (last_invalidator_[index] >= 0) {
+    entries_[last_invalidator_[index]].caused_builds[index].Add(stats);
+  }
+}
+
+const char* AnalysisReport::AnalysisName(uint32_t index) {
+  static const char* const kNames[kNumAnalyses] = {
+      "def-use",          "instr-to-block", "decorations",
+      "combinators",      "cfg",            "dominators",
+      "loops",            "name-map",       "scalar-evolution",
+      "register-pressure", "value-numbers", "structured-cfg",
+      "builtin-var-ids",  "id-to-func",     "constants",
+      "types",            "debug-info",     "liveness",
+      "id-to-graph"};
+  assert(index < kNumAnalyses);
+  return kNames[index];
+}
+
+void AnalysisReport::Print(std::ostream& out) const {
+  auto print_faults = [&out](long faults) {
+    if (faults < 0) {
+      out << std::setw(10) << "n/a";
+    } else {
+      out << std::setw(10) << faults;
+    }
+  };
+
+  const auto old_flags = out.flags();
+  const auto old_precision = out.precision(6);
+  out << std::fixed;
+
+  out << "Analysis builds per pass:\n";
+  for (const PassEntry& entry : entries_) {
+    out << entry.pass_name << "\n";
+    if (entry.invalidated != 0) {
+      out << "  invalidated:";
+      for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+        if (entry.invalidated & (1u << i)) out << " " << AnalysisName(i);
+      }
+      out << "\n";
+    }
+    for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+      const BuildStats& stats = entry.builds[i];
+      if (stats.count == 0) continue;
+      out << "  " << std::left << std::setw(18) << AnalysisName(i)
+          << std::right << std::setw(6) << stats.count << " builds"
+          << std::setw(12) << stats.seconds << " s";
+      print_faults(stats.page_faults);
+      out << " page faults\n";
+    }
+  }
+
+  // Each pass and analysis whose invalidation led to builds, most expensive
+  // first.
+  std::vector<std::tuple<double, size_t, uint32_t>> blame;
+  for (size_t e = 0; e < entries_.size(); ++e) {
+    for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+      if (entries_[e].caused_builds[i].count != 0) {
+        blame.emplace_back(entries_[e].caused_builds[i].seconds, e, i);
+      }
+    }
+  }
+  std::stable_sort(blame.begin(), blame.end(),
+                   [](const std::tuple<double, size_t, uint32_t>& a,
+                      const std::tuple<double, size_t, uint32_t>& b) {
+                     return std::get<0>(a) > std::get<0>(b);
+                   });
+
+  out << "Builds caused by passes that did not preserve an analysis:\n";
+  out << std::setw(12) << "seconds" << std::setw(8) << "builds"
+      << std::setw(10) << "faults" << "  " << std::left << std::setw(18)
+      << "analysis"
+      << "pass\n"
+      << std::right;
+  for (const auto& item : blame) {
+    const PassEntry& entry = entries_[std::get<1>(item)];
+    const BuildStats& stats = entry.caused_builds[std::get<2>(item)];
+    out << std::setw(12) << stats.seconds << std::setw(8) << stats.count;
+    print_faults(stats.page_faults);
+    out << "  " << std::left << std::setw(18) << AnalysisName(std::get<2>(item))
+        << entry.pass_name << "\n"
+        << std::right;
+  }
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+}  // namespace opt
+}  // namespace spvtools
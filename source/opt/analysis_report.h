@@ -0,0 +1,135 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_ANALYSIS_REPORT_H_
+#define SOURCE_OPT_ANALYSIS_REPORT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace spvtools {
+namespace opt {
+
+class Profiler;
+
+// Records, for each pass, which analyses of the IRContext it invalidated and
+// what building analyses cost while it ran. Analyses are identified by their
+// IRContext::Analysis bit.
+//
+// A build is also charged to the pass that last invalidated the analysis,
+// since that pass is why it had to be built again. Those totals show which
+// passes would gain the most from a better GetPreservedAnalyses().
+//
+// A report is not thread-safe. Builds that run on several threads must be
+// recorded as one build scope on the calling thread.
+class AnalysisReport {
+ public:
+  // The number of analyses, one per IRContext::Analysis bit below
+  // kAnalysisEnd.
+  static constexpr uint32_t kNumAnalyses = 19;
+
+  // The cost of building one analysis.
+  struct BuildStats {
+    // The number of builds. A per-function analysis counts each function.
+    uint32_t count = 0;
+    // The wall time spent building, excluding nested builds of other
+    // analyses.
+    double seconds = 0;
+    // The minor and major page faults during the builds, excluding nested
+    // builds. Each fault is a page the builds touched for the first time, so
+    // this approximates the memory they allocated. It is -1 if the platform
+    // does not report page faults.
+    long page_faults = 0;
+
+    void Add(const BuildStats& other);
+  };
+
+  // What happened to the analyses during one pass.
+  struct PassEntry {
+    std::string pass_name;
+    // The valid analyses that were invalidated while the pass ran, including
+    // the ones the pass did not list as preserved.
+    uint32_t invalidated = 0;
+    // The analyses built while the pass ran, indexed by bit position.
+    BuildStats builds[kNumAnalyses];
+    // The builds of later passes that were needed because this pass was the
+    // last one to invalidate the analysis, indexed by bit position.
+    BuildStats caused_builds[kNumAnalyses];
+  };
+
+  // Measures one build of |analysis| for as long as it lives. The scope does
+  // nothing if |report| is null. |count| is the number of builds it stands
+  // for.
+  class ScopedBuild {
+   public:
+    ScopedBuild(AnalysisReport* report, uint32_t analysis, uint32_t count = 1);
+    ~ScopedBuild();
+
+    ScopedBuild(const ScopedBuild&) = delete;
+    ScopedBuild& operator=(const ScopedBuild&) = delete;
+
+   private:
+    AnalysisReport* report_;
+    uint32_t analysis_;
+    uint32_t count_;
+    std::chrono::steady_clock::time_point start_;
+    long start_page_faults_;
+  };
+
+  AnalysisReport();
+
+  // Starts a new entry for the pass |name|. Invalidations and builds are
+  // recorded against it until the next call.
+  void BeginPass(const char* name);
+
+  // Makes every build also add a trace event to |profiler|, if it is not null.
+  // The report does not take ownership of |profiler|.
+  void SetProfiler(Profiler* profiler) { profiler_ = profiler; }
+
+  // Records that the valid analyses in |analyses| were invalidated.
+  void RecordInvalidation(uint32_t analyses);
+
+  // Returns the entries, one per pass in the order they ran.
+  const std::vector<PassEntry>& entries() const { return entries_; }
+
+  // Writes the report as text to |out|: a table of the builds and
+  // invalidations of each pass, then the build cost each pass caused by not
+  // preserving analyses, most expensive first.
+  void Print(std::ostream& out) const;
+
+  // Returns the name of the analysis at bit position |index|.
+  static const char* AnalysisName(uint32_t index);
+
+ private:
+  // Adds |stats| to the builds of |analysis| in the current pass.
+  void RecordBuild(uint32_t analysis, const BuildStats& stats);
+
+  std::vector<PassEntry> entries_;
+  // For each analysis, the index in |entries_| of the last pass that
+  // invalidated it, or -1.
+  int last_invalidator_[kNumAnalyses];
+  // The time and page faults of the nested builds in each open scope, so that
+  // the enclosing scope can leave them out.
+  std::vector<BuildStats> nested_;
+  // The profiler that builds are traced in, or null.
+  Profiler* profiler_ = nullptr;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_ANALYSIS_REPORT_H_
@@ -29,6 +29,7 @@
 #include "source/opt/instruction.h"
 #include "source/opt/instruction_list.h"
 #include "source/opt/iterator.h"
+#include "source/util/arena.h"
 
 namespace spvtools {
 namespace opt {
@@ -37,7 +38,7 @@ class Function;
 class IRContext;
 
 // A SPIR-V basic block.
-class BasicBlock {
+class BasicBlock : public utils::ArenaObject {
  public:
   using iterator = InstructionList::iterator;
   using const_iterator = InstructionList::const_iterator;
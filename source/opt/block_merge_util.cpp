@@ -187,6 +187,13 @@ void MergeWithSuccessor(IRContext* context, Function* func,
     context->InvalidateAnalyses(IRContext::Analysis::kAnalysisStructuredCFG);
   }
 
+  // Keep the CFG and the dominator trees up to date, so that the caller does
+  // not have to rebuild them. This has to happen while sbi is still intact.
+  if (context->AreAnalysesValid(IRContext::kAnalysisCFG)) {
+    context->cfg()->MergeIntoPredecessor(&*bi, &*sbi);
+  }
+  context->UpdateDominatorsForMergedBlocks(func, &*bi, &*sbi);
+
   // Update the inst-to-block mapping for the instructions in sbi.
   for (auto& inst : *sbi) {
     context->set_instr_block(&inst, &*bi);
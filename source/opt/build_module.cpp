@@ -20,6 +20,7 @@
 #include "source/opt/ir_context.h"
 #include "source/opt/ir_loader.h"
 #include "source/table.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 
 namespace spvtools {
@@ -62,6 +63,7 @@ std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
   SetContextMessageConsumer(context, consumer);
 
   auto irContext = MakeUnique<opt::IRContext>(env, consumer);
+  utils::ArenaScope arena_scope(irContext->arena());
   opt::IrLoader loader(consumer, irContext->module());
   loader.SetExtraLineTracking(extra_line_tracking);
 
@@ -14,6 +14,7 @@
 
 #include "source/opt/cfg.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -72,6 +73,17 @@ void CFG::RemoveNonExistingEdges(uint32_t blk_id) {
   label2preds_.at(blk_id) = std::move(updated_pred_list);
 }
 
+void CFG::MergeIntoPredecessor(const BasicBlock* pred, const BasicBlock* blk) {
+  const uint32_t pred_id = pred->id();
+  const uint32_t blk_id = blk->id();
+  blk->ForEachSuccessorLabel([pred_id, blk_id, this](const uint32_t succ_id) {
+    auto& preds_list = label2preds_[succ_id];
+    std::replace(preds_list.begin(), preds_list.end(), blk_id, pred_id);
+  });
+  id2block_.erase(blk_id);
+  label2preds_.erase(blk_id);
+}
+
 void CFG::ComputeStructuredOrder(Function* func, BasicBlock* root,
                                  std::list<BasicBlock*>* order) {
   ComputeStructuredOrder(func, root, nullptr, order);
@@ -130,6 +130,12 @@ class CFG {
   // the basic block id |blk_id|.
   void RemoveNonExistingEdges(uint32_t blk_id);
 
+  // Removes |blk| from the CFG once it has been merged into |pred|, its only
+  // predecessor. |pred| takes the place of |blk| in the predecessor list of
+  // each successor of |blk|, so the order of those lists does not change.
+  // |blk| must still have its terminator.
+  void MergeIntoPredecessor(const BasicBlock* pred, const BasicBlock* blk);
+
   // Remove all edges that leave |bb|.
   void RemoveSuccessorEdges(const BasicBlock* bb) {
     bb->ForEachSuccessorLabel(
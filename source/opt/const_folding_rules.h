@@ -15,10 +15,12 @@
 #ifndef SOURCE_OPT_CONST_FOLDING_RULES_H_
 #define SOURCE_OPT_CONST_FOLDING_RULES_H_
 
-#include <unordered_map>
+#include <functional>
+#include <ostream>
 #include <vector>
 
 #include "source/opt/constants.h"
+#include "source/opt/folding_rule_table.h"
 
 namespace spvtools {
 namespace opt {
@@ -53,30 +55,9 @@ using ConstantFoldingRule = std::function<const analysis::Constant*(
     const std::vector<const analysis::Constant*>& constants)>;
 
 class ConstantFoldingRules {
- protected:
-  // The |Key| and |Value| structs are used to by-pass a "decorated name length
-  // exceeded, name was truncated" warning on VS2013 and VS2015.
-  struct Key {
-    uint32_t instruction_set;
-    uint32_t opcode;
-  };
-
-  friend bool operator<(const Key& a, const Key& b) {
-    if (a.instruction_set < b.instruction_set) {
-      return true;
-    }
-    if (a.instruction_set > b.instruction_set) {
-      return false;
-    }
-    return a.opcode < b.opcode;
-  }
-
-  struct Value {
-    std::vector<ConstantFoldingRule> value;
-    void push_back(ConstantFoldingRule rule) { value.push_back(rule); }
-  };
-
  public:
+  using ConstantFoldingRuleSet = FoldingRuleList<ConstantFoldingRule>;
+
   ConstantFoldingRules(IRContext* ctx) : context_(ctx) {}
   virtual ~ConstantFoldingRules() = default;
 
@@ -85,49 +66,41 @@ class ConstantFoldingRules {
     return !GetRulesForInstruction(inst).empty();
   }
 
-  // Returns true if there is at least 1 folding rule for |inst|.
-  const std::vector<ConstantFoldingRule>& GetRulesForInstruction(
+  // Returns the folding rules for |inst|, which may be empty.
+  const ConstantFoldingRuleSet& GetRulesForInstruction(
       const Instruction* inst) const {
     if (inst->opcode() != spv::Op::OpExtInst) {
-      auto it = rules_.find(inst->opcode());
-      if (it != rules_.end()) {
-        return it->second.value;
-      }
-    } else {
-      uint32_t ext_inst_id = inst->GetSingleWordInOperand(0);
-      uint32_t ext_opcode = inst->GetSingleWordInOperand(1);
-      auto it = ext_rules_.find({ext_inst_id, ext_opcode});
-      if (it != ext_rules_.end()) {
-        return it->second.value;
-      }
+      return rules_.Find(inst->opcode());
     }
-    return empty_vector_;
+    return ext_rules_.Find(inst->GetSingleWordInOperand(0),
+                           inst->GetSingleWordInOperand(1));
   }
 
   // Add the folding rules.
   virtual void AddFoldingRules();
 
- protected:
-  struct hasher {
-    size_t operator()(const spv::Op& op) const noexcept {
-      return std::hash<uint32_t>()(uint32_t(op));
-    }
-  };
+  // Starts counting the hits and misses of every rule.
+  void EnableStatistics() {
+    rules_.EnableStatistics();
+    ext_rules_.EnableStatistics();
+  }
 
+  // Writes the hits and misses of the rules that were tried to |out|.
+  void PrintStatistics(std::ostream& out) const {
+    PrintFoldingRuleStats(rules_, ext_rules_, out);
+  }
+
+ protected:
   // |rules[opcode]| is the set of rules that can be applied to instructions
   // with |opcode| as the opcode.
-  std::unordered_map<spv::Op, Value, hasher> rules_;
+  OpcodeRuleTable<ConstantFoldingRule> rules_;
 
   // The folding rules for extended instructions.
-  std::map<Key, Value> ext_rules_;
+  ExtInstRuleTable<ConstantFoldingRule> ext_rules_;
 
  private:
   // The context that the instruction to be folded will be a part of.
   IRContext* context_;
-
-  // The empty set of rules to be used as the default return value in
-  // |GetRulesForInstruction|.
-  std::vector<ConstantFoldingRule> empty_vector_;
 };
 
 }  // namespace opt
@@ -14,6 +14,9 @@
 
 #include "source/opt/def_use_manager.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace spvtools {
 namespace opt {
 namespace analysis {
@@ -52,9 +55,8 @@ void DefUseManager::AnalyzeInstUse(Instruction* inst) {
       case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
       case SPV_OPERAND_TYPE_SCOPE_ID: {
         uint32_t use_id = inst->GetSingleWordOperand(i);
-        Instruction* def = GetDef(use_id);
-        assert(def && "Definition is not registered.");
-        id_to_users_.insert(UserEntry{def, inst});
+        assert(GetDef(use_id) && "Definition is not registered.");
+        AddUser(use_id, inst);
         used_ids->push_back(use_id);
       } break;
       default:
@@ -94,21 +96,64 @@ const Instruction* DefUseManager::GetDef(uint32_t id) const {
   return iter->second;
 }
 
-DefUseManager::IdToUsersMap::const_iterator DefUseManager::UsersBegin(
-    const Instruction* def) const {
-  return id_to_users_.lower_bound(
-      UserEntry{const_cast<Instruction*>(def), nullptr});
+DefUseManager::UserList& DefUseManager::GetUserList(uint32_t id) {
+  if (id >= id_to_users_.size()) {
+    id_to_users_.resize(id + 1);
+  }
+  return id_to_users_[id];
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const IdToUsersMap::const_iterator& cached_end,
-                                const Instruction* inst) const {
-  return (iter != cached_end && iter->def == inst);
+void DefUseManager::AddUser(uint32_t id, Instruction* user) {
+  UserList& list = GetUserList(id);
+  std::vector<UserSlot>& slots = list.slots;
+  const uint32_t unique_id = user->unique_id();
+
+  // The common case: the user was created after every other user.
+  if (slots.empty() || slots.back().unique_id < unique_id) {
+    slots.push_back({unique_id, user});
+    return;
+  }
+
+  auto iter = std::lower_bound(slots.begin(), slots.end(), unique_id,
+                               [](const UserSlot& slot, uint32_t value) {
+                                 return slot.unique_id < value;
+                               });
+  if (iter != slots.end() && iter->unique_id == unique_id) {
+    if (iter->user == nullptr) {
+      // The user was removed and is now added back.
+      iter->user = user;
+      --list.num_removed;
+    }
+    return;
+  }
+  slots.insert(iter, {unique_id, user});
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const Instruction* inst) const {
-  return UsersNotEnd(iter, id_to_users_.end(), inst);
+void DefUseManager::RemoveUser(uint32_t id, const Instruction* user) {
+  if (id >= id_to_users_.size()) return;
+  UserList& list = id_to_users_[id];
+  std::vector<UserSlot>& slots = list.slots;
+  auto iter = std::lower_bound(slots.begin(), slots.end(), user->unique_id(),
+                               [](const UserSlot& slot, uint32_t value) {
+                                 return slot.unique_id < value;
+                               });
+  if (iter == slots.end() || iter->user != user) return;
+
+  iter->user = nullptr;
+  ++list.num_removed;
+  if (2 * list.num_removed > slots.size()) {
+    Compact(&list);
+  }
+}
+
+void DefUseManager::Compact(UserList* list) {
+  std::vector<UserSlot>& slots = list->slots;
+  slots.erase(std::remove_if(slots.begin(), slots.end(),
+                             [](const UserSlot& slot) {
+                               return slot.user == nullptr;
+                             }),
+              slots.end());
+  list->num_removed = 0;
 }
 
 bool DefUseManager::WhileEachUser(
@@ -118,9 +163,28 @@ bool DefUseManager::WhileEachUser(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    if (!f(iter->user)) return false;
+  const uint32_t id = def->result_id();
+  if (id >= id_to_users_.size()) return true;
+
+  // |f| may add and remove users, which can move the slots and reallocate
+  // both the list and |id_to_users_|. The next user is therefore the first
+  // one after the unique id of the last one visited. The list is only
+  // searched again if the slot that was visited has moved.
+  size_t i = 0;
+  while (i < id_to_users_[id].slots.size()) {
+    const UserSlot slot = id_to_users_[id].slots[i];
+    if (slot.user != nullptr && !f(slot.user)) return false;
+
+    const std::vector<UserSlot>& slots = id_to_users_[id].slots;
+    if (i < slots.size() && slots[i].unique_id == slot.unique_id) {
+      ++i;
+    } else {
+      i = std::upper_bound(slots.begin(), slots.end(), slot.unique_id,
+                           [](uint32_t value, const UserSlot& other) {
+                             return value < other.unique_id;
+                           }) -
+          slots.begin();
+    }
   }
   return true;
 }
@@ -151,19 +215,18 @@ bool DefUseManager::WhileEachUse(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    Instruction* user = iter->user;
+  const uint32_t id = def->result_id();
+  return WhileEachUser(def, [id, &f](Instruction* user) {
     for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
       const Operand& op = user->GetOperand(idx);
       if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
-        if (def->result_id() == op.words[0]) {
+        if (id == op.words[0]) {
           if (!f(user, idx)) return false;
         }
       }
     }
-  }
-  return true;
+    return true;
+  });
 }
 
 bool DefUseManager::WhileEachUse(
@@ -220,6 +283,7 @@ std::vector<Instruction*> DefUseManager::GetAnnotations(uint32_t id) const {
 
 void DefUseManager::AnalyzeDefUse(Module* module) {
   if (!module) return;
+  id_to_users_.reserve(module->IdBound());
   // Analyze all the defs before any uses to catch forward references.
   module->ForEachInst(
       std::bind(&DefUseManager::AnalyzeInstDef, this, std::placeholders::_1),
@@ -233,15 +297,13 @@ void DefUseManager::ClearInst(Instruction* inst) {
   auto iter = inst_to_used_ids_.find(inst);
   if (iter != inst_to_used_ids_.end()) {
     EraseUseRecordsOfOperandIds(inst);
-    if (inst->result_id() != 0) {
+    const uint32_t result_id = inst->result_id();
+    if (result_id != 0) {
       // Remove all uses of this inst.
-      auto users_begin = UsersBegin(inst);
-      auto end = id_to_users_.end();
-      auto new_end = users_begin;
-      for (; UsersNotEnd(new_end, end, inst); ++new_end) {
+      if (result_id < id_to_users_.size() && GetDef(result_id) == inst) {
+        id_to_users_[result_id] = UserList();
       }
-      id_to_users_.erase(users_begin, new_end);
-      id_to_def_.erase(inst->result_id());
+      id_to_def_.erase(result_id);
     }
   }
 }
@@ -252,8 +314,7 @@ void DefUseManager::EraseUseRecordsOfOperandIds(const Instruction* inst) {
   auto iter = inst_to_used_ids_.find(inst);
   if (iter != inst_to_used_ids_.end()) {
     for (auto use_id : iter->second) {
-      id_to_users_.erase(
-          UserEntry{GetDef(use_id), const_cast<Instruction*>(inst)});
+      RemoveUser(use_id, inst);
     }
     inst_to_used_ids_.erase(iter);
   }
@@ -277,14 +338,28 @@ bool CompareAndPrintDifferences(const DefUseManager& lhs,
     same = false;
   }
 
-  if (lhs.id_to_users_ != rhs.id_to_users_) {
-    for (auto p : lhs.id_to_users_) {
-      if (rhs.id_to_users_.count(p) == 0) {
+  // Lists the {id, user} pairs recorded by |manager| in a canonical order.
+  auto get_users = [](const DefUseManager& manager) {
+    std::vector<std::pair<uint32_t, const Instruction*>> users;
+    for (uint32_t id = 0; id < manager.id_to_users_.size(); ++id) {
+      for (const auto& slot : manager.id_to_users_[id].slots) {
+        if (slot.user != nullptr) users.emplace_back(id, slot.user);
+      }
+    }
+    std::sort(users.begin(), users.end());
+    users.erase(std::unique(users.begin(), users.end()), users.end());
+    return users;
+  };
+  const auto lhs_users = get_users(lhs);
+  const auto rhs_users = get_users(rhs);
+  if (lhs_users != rhs_users) {
+    for (const auto& p : lhs_users) {
+      if (!std::binary_search(rhs_users.begin(), rhs_users.end(), p)) {
         printf("Diff in id_to_users: missing value in rhs\n");
       }
     }
-    for (auto p : rhs.id_to_users_) {
-      if (lhs.id_to_users_.count(p) == 0) {
+    for (const auto& p : rhs_users) {
+      if (!std::binary_search(lhs_users.begin(), lhs_users.end(), p)) {
         printf("Diff in id_to_users: missing value in lhs\n");
       }
     }
@@ -15,7 +15,6 @@
 #ifndef SOURCE_OPT_DEF_USE_MANAGER_H_
 #define SOURCE_OPT_DEF_USE_MANAGER_H_
 
-#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -27,50 +26,6 @@ namespace spvtools {
 namespace opt {
 namespace analysis {
 
-// Definition should never be null. User can be null, however, such an entry
-// should be used only for searching (e.g. all users of a particular definition)
-// and never stored in a container.
-struct UserEntry {
-  Instruction* def;
-  Instruction* user;
-};
-
-inline bool operator==(const UserEntry& lhs, const UserEntry& rhs) {
-  return lhs.def == rhs.def && lhs.user == rhs.user;
-}
-
-// Orders UserEntry for use in associative containers (i.e. less than ordering).
-//
-// The definition of an UserEntry is treated as the major key and the users as
-// the minor key so that all the users of a particular definition are
-// consecutive in a container.
-//
-// A null user always compares less than a real user. This is done to provide
-// easy values to search for the beginning of the users of a particular
-// definition (i.e. using {def, nullptr}).
-struct UserEntryLess {
-  bool operator()(const UserEntry& lhs, const UserEntry& rhs) const {
-    // If lhs.def and rhs.def are both null, fall through to checking the
-    // second entries.
-    if (!lhs.def && rhs.def) return true;
-    if (lhs.def && !rhs.def) return false;
-
-    // If neither definition is null, then compare unique ids.
-    if (lhs.def && rhs.def) {
-      if (lhs.def->unique_id() < rhs.def->unique_id()) return true;
-      if (rhs.def->unique_id() < lhs.def->unique_id()) return false;
-    }
-
-    // Return false on equality.
-    if (!lhs.user && !rhs.user) return false;
-    if (!lhs.user) return true;
-    if (!rhs.user) return false;
-
-    // If neither user is null then compare unique ids.
-    return lhs.user->unique_id() < rhs.user->unique_id();
-  }
-};
-
 // A class for analyzing and managing defs and uses in an Module.
 class DefUseManager {
  public:
@@ -104,11 +59,16 @@ class DefUseManager {
   const Instruction* GetDef(uint32_t id) const;
 
   // Runs the given function |f| on each unique user instruction of |def| (or
-  // |id|).
+  // |id|), in the order the users were created.
   //
   // If one instruction uses |def| in multiple operands, that instruction will
   // only be visited once.
   //
+  // |f| may add and remove users of |def|. A user removed before it is reached
+  // is not visited. A user added during the iteration is visited if it was
+  // created after the user being visited, which is always the case for a new
+  // instruction.
+  //
   // |def| (or |id|) must be registered as a definition.
   void ForEachUser(const Instruction* def,
                    const std::function<void(Instruction*)>& f) const;
@@ -120,7 +80,8 @@ class DefUseManager {
   // returns false.
   //
   // If one instruction uses |def| in multiple operands, that instruction will
-  // be only be visited once.
+  // be only be visited once. Users are visited in the same order as, and
+  // changes made by |f| are handled like, ForEachUser.
   //
   // |def| (or |id|) must be registered as a definition.
   bool WhileEachUser(const Instruction* def,
@@ -193,32 +154,52 @@ class DefUseManager {
   void UpdateDefUse(Instruction* inst);
 
  private:
-  using IdToUsersMap = std::set<UserEntry, UserEntryLess>;
   using InstToUsedIdsMap =
       std::unordered_map<const Instruction*, std::vector<uint32_t>>;
 
-  // Returns the first location that {|def|, nullptr} could be inserted into the
-  // users map without violating ordering.
-  IdToUsersMap::const_iterator UsersBegin(const Instruction* def) const;
+  // A user of a definition, or a removed user if |user| is null. The unique id
+  // of the user is kept next to the pointer so that lists can be searched
+  // without touching the instructions.
+  struct UserSlot {
+    uint32_t unique_id;
+    Instruction* user;
+  };
 
-  // Returns true if |iter| has not reached the end of |def|'s users.
+  // The users of one definition. Each user appears once, no matter how many of
+  // its operands refer to the definition.
   //
-  // In the first version |iter| is compared against the end of the map for
-  // validity before other checks. In the second version, |iter| is compared
-  // against |cached_end| for validity before other checks. This allows caching
-  // the map's end which is a performance improvement on some platforms.
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const Instruction* def) const;
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const IdToUsersMap::const_iterator& cached_end,
-                   const Instruction* def) const;
+  // The slots are always ordered by unique id, so the lists are only changed
+  // by the non-const methods and the queries only read them. New instructions
+  // have the highest unique id, so users are almost always appended. Removing
+  // a user only clears its slot, which keeps its place for the user to be
+  // added back, as happens when an instruction is analyzed again. Cleared
+  // slots are dropped once they make up half of the list.
+  struct UserList {
+    std::vector<UserSlot> slots;
+    uint32_t num_removed = 0;
+  };
+
+  // Returns the users of |id|, creating an empty list if needed.
+  UserList& GetUserList(uint32_t id);
+
+  // Records that |user| uses |id|. Does nothing if that is already recorded.
+  void AddUser(uint32_t id, Instruction* user);
+
+  // Removes the record that |user| uses |id|, if there is one.
+  void RemoveUser(uint32_t id, const Instruction* user);
+
+  // Drops the removed slots of |list|.
+  static void Compact(UserList* list);
 
   // Analyzes the defs and uses in the given |module| and populates data
   // structures in this class. Does nothing if |module| is nullptr.
   void AnalyzeDefUse(Module* module);
 
-  IdToDefMap id_to_def_;      // Mapping from ids to their definitions
-  IdToUsersMap id_to_users_;  // Mapping from ids to their users
+  IdToDefMap id_to_def_;  // Mapping from ids to their definitions
+  // Mapping from ids to their users, indexed by id. The const methods do not
+  // change it, so they may run on several threads at once, as long as no
+  // non-const method runs at the same time.
+  std::vector<UserList> id_to_users_;
   // Mapping from instructions to the ids used in the instruction.
   InstToUsedIdsMap inst_to_used_ids_;
 };
@@ -112,6 +112,12 @@ class DominatorAnalysisBase {
     tree_.Visit(func);
   }
 
+  // Updates the tree after |succ| has been merged into |pred|. See
+  // DominatorTree::MergeBlocks.
+  inline void MergeBlocks(BasicBlock* pred, BasicBlock* succ) {
+    tree_.MergeBlocks(pred, succ);
+  }
+
   // Returns the most immediate basic block that dominates both |b1| and |b2|.
   // If there is no such basic block, nullptr is returned.
   BasicBlock* CommonDominator(BasicBlock* b1, BasicBlock* b2) const;
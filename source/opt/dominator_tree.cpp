@@ -249,10 +249,8 @@ BasicBlock* DominatorTree::ImmediateDominator(const BasicBlock* A) const {
 
 BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
   // Check that A is a valid node in the tree.
-  auto a_itr = nodes_.find(a);
-  if (a_itr == nodes_.end()) return nullptr;
-
-  const DominatorTreeNode* node = &a_itr->second;
+  const DominatorTreeNode* node = GetTreeNode(a);
+  if (node == nullptr) return nullptr;
 
   if (node->parent_ == nullptr) {
     return nullptr;
@@ -262,18 +260,52 @@ BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
 }
 
 DominatorTreeNode* DominatorTree::GetOrInsertNode(BasicBlock* bb) {
-  DominatorTreeNode* dtn = nullptr;
+  DominatorTreeNode*& dtn = id_to_node_[bb->id()];
+  if (dtn == nullptr) {
+    nodes_.emplace_back(bb);
+    dtn = &nodes_.back();
+  }
+  return dtn;
+}
 
-  std::map<uint32_t, DominatorTreeNode>::iterator node_iter =
-      nodes_.find(bb->id());
-  if (node_iter == nodes_.end()) {
-    dtn = &nodes_.emplace(std::make_pair(bb->id(), DominatorTreeNode{bb}))
-               .first->second;
-  } else {
-    dtn = &node_iter->second;
+void DominatorTree::RemoveNode(DominatorTreeNode* node) {
+  assert(node->children_.empty() && "The children must be moved first.");
+  if (DominatorTreeNode* parent = node->parent_) {
+    auto& siblings = parent->children_;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
   }
+  id_to_node_.erase(node->id());
+  // The slot in |nodes_| is left behind, since other nodes cannot move.
+  node->parent_ = nullptr;
+  node->bb_ = nullptr;
+}
 
-  return dtn;
+void DominatorTree::MergeBlocks(BasicBlock* pred, BasicBlock* succ) {
+  // In a dominator tree |pred| is the parent of |succ|, and in a post-dominator
+  // tree |succ| is the parent of |pred|. Either way, the child is dropped and
+  // its children move up to the parent, where they are still numbered inside
+  // the parent's interval. Neither node exists if the blocks are unreachable.
+  DominatorTreeNode* pred_node = GetTreeNode(pred);
+  DominatorTreeNode* succ_node = GetTreeNode(succ);
+  if (pred_node == nullptr || succ_node == nullptr) return;
+
+  DominatorTreeNode* parent = postdominator_ ? succ_node : pred_node;
+  DominatorTreeNode* child = postdominator_ ? pred_node : succ_node;
+  assert(child->parent_ == parent);
+  for (DominatorTreeNode* grandchild : child->children_) {
+    grandchild->parent_ = parent;
+    parent->children_.push_back(grandchild);
+  }
+  child->children_.clear();
+  RemoveNode(child);
+
+  if (postdominator_) {
+    // The surviving node now stands for the merged block, which has the id of
+    // |pred|.
+    id_to_node_.erase(succ->id());
+    parent->bb_ = pred;
+    id_to_node_[pred->id()] = parent;
+  }
 }
 
 void DominatorTree::GetDominatorEdges(
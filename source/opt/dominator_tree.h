@@ -17,7 +17,8 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <map>
+#include <deque>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -92,8 +93,6 @@ struct DominatorTreeNode {
 // node is dominated by its parent.
 class DominatorTree {
  public:
-  // Map OpLabel ids to dominator tree nodes
-  using DominatorTreeNodeMap = std::map<uint32_t, DominatorTreeNode>;
   using iterator = TreeDFIterator<DominatorTreeNode>;
   using const_iterator = TreeDFIterator<const DominatorTreeNode>;
   using post_iterator = PostOrderTreeDFIterator<DominatorTreeNode>;
@@ -205,6 +204,7 @@ class DominatorTree {
   // Clean up the tree.
   void ClearTree() {
     nodes_.clear();
+    id_to_node_.clear();
     roots_.clear();
   }
 
@@ -253,20 +253,20 @@ class DominatorTree {
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
   inline DominatorTreeNode* GetTreeNode(uint32_t id) {
-    DominatorTreeNodeMap::iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
+    auto node_iter = id_to_node_.find(id);
+    if (node_iter == id_to_node_.end()) {
       return nullptr;
     }
-    return &node_iter->second;
+    return node_iter->second;
   }
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
   inline const DominatorTreeNode* GetTreeNode(uint32_t id) const {
-    DominatorTreeNodeMap::const_iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
+    auto node_iter = id_to_node_.find(id);
+    if (node_iter == id_to_node_.end()) {
       return nullptr;
     }
-    return &node_iter->second;
+    return node_iter->second;
   }
 
   // Adds the basic block |bb| to the tree structure if it doesn't already
@@ -276,6 +276,12 @@ class DominatorTree {
   // Recomputes the DF numbering of the tree.
   void ResetDFNumbering();
 
+  // Updates the tree after the block |succ| has been merged into the block
+  // |pred|. |pred| must have been the only predecessor of |succ| and |succ|
+  // the only successor of |pred|. The merged block keeps the id of |pred|.
+  // The DF numbering stays valid, so no renumbering is needed.
+  void MergeBlocks(BasicBlock* pred, BasicBlock* succ);
+
  private:
   // Wrapper function which gets the list of pairs of each BasicBlocks to its
   // immediately  dominating BasicBlock and stores the result in the edges
@@ -289,11 +295,18 @@ class DominatorTree {
       const Function* f, const BasicBlock* dummy_start_node,
       std::vector<std::pair<BasicBlock*, BasicBlock*>>* edges);
 
+  // Removes |node| from the tree. Its children must already have been moved.
+  void RemoveNode(DominatorTreeNode* node);
+
   // The roots of the tree.
   std::vector<DominatorTreeNode*> roots_;
 
+  // The tree nodes, stored contiguously in creation order. A deque keeps the
+  // nodes in place as more are added, so the tree links stay valid.
+  std::deque<DominatorTreeNode> nodes_;
+
   // Pairs each basic block id to the tree node containing that basic block.
-  DominatorTreeNodeMap nodes_;
+  std::unordered_map<uint32_t, DominatorTreeNode*> id_to_node_;
 
   // True if this is a post dominator tree.
   bool postdominator_;
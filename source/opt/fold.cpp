@@ -190,9 +190,12 @@ bool InstructionFolder::FoldInstructionInternal(Instruction* inst) const {
   std::vector<const analysis::Constant*> constants =
       const_manager->GetOperandConstants(inst);
 
-  for (const FoldingRule& rule :
-       GetFoldingRules().GetRulesForInstruction(inst)) {
-    if (rule(context_, inst, constants)) {
+  const FoldingRules::FoldingRuleSet& rules =
+      GetFoldingRules().GetRulesForInstruction(inst);
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const bool folded = rules[i](context_, inst, constants);
+    rules.RecordResult(i, folded);
+    if (folded) {
       return true;
     }
   }
@@ -575,8 +578,10 @@ Instruction* InstructionFolder::FoldInstructionToConstant(
     Instruction* inst, std::function<uint32_t(uint32_t)> id_map) const {
   analysis::ConstantManager* const_mgr = context_->get_constant_mgr();
 
+  const ConstantFoldingRules::ConstantFoldingRuleSet& rules =
+      GetConstantFoldingRules().GetRulesForInstruction(inst);
   if (!inst->IsFoldableByFoldScalar() && !inst->IsFoldableByFoldVector() &&
-      !GetConstantFoldingRules().HasFoldingRule(inst)) {
+      rules.empty()) {
     return nullptr;
   }
   // Collect the values of the constant parameters.
@@ -595,8 +600,9 @@ Instruction* InstructionFolder::FoldInstructionToConstant(
   });
 
   const analysis::Constant* folded_const = nullptr;
-  for (auto rule : GetConstantFoldingRules().GetRulesForInstruction(inst)) {
-    folded_const = rule(context_, inst, constants);
+  for (size_t i = 0; i < rules.size(); ++i) {
+    folded_const = rules[i](context_, inst, constants);
+    rules.RecordResult(i, folded_const != nullptr);
     if (folded_const == nullptr && inst->context()->id_overflow()) {
       return nullptr;
     }
@@ -700,5 +706,12 @@ bool InstructionFolder::FoldInstruction(Instruction* inst) const {
   return modified;
 }
 
+void InstructionFolder::PrintRuleStatistics(std::ostream& out) const {
+  out << "Constant folding rules:\n";
+  GetConstantFoldingRules().PrintStatistics(out);
+  out << "Folding rules:\n";
+  GetFoldingRules().PrintStatistics(out);
+}
+
 }  // namespace opt
 }  // namespace spvtools
@@ -16,6 +16,7 @@
 #define SOURCE_OPT_FOLD_H_
 
 #include <cstdint>
+#include <ostream>
 #include <vector>
 
 #include "source/opt/const_folding_rules.h"
@@ -123,6 +124,18 @@ class InstructionFolder {
     return GetConstantFoldingRules().HasFoldingRule(inst);
   }
 
+  // Starts counting, for every folding rule, the instructions it folded (hits)
+  // and the instructions it was tried on without folding them (misses).
+  // Counting is off by default.
+  void EnableRuleStatistics() {
+    const_folding_rules_->EnableStatistics();
+    folding_rules_->EnableStatistics();
+  }
+
+  // Writes the hits and misses of the folding rules that were tried since
+  // EnableRuleStatistics() to |out|.
+  void PrintRuleStatistics(std::ostream& out) const;
+
  private:
   // Returns a reference to the ConstnatFoldingRules instance.
   const ConstantFoldingRules& GetConstantFoldingRules() const {
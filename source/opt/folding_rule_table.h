@@ -0,0 +1,253 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_FOLDING_RULE_TABLE_H_
+#define SOURCE_OPT_FOLDING_RULE_TABLE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "source/opcode.h"
+
+namespace spvtools {
+namespace opt {
+
+// The number of instructions a folding rule was tried on, split by whether the
+// rule folded them.
+struct FoldingRuleStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+// The folding rules that apply to one opcode, in order of priority.
+//
+// The list can also count the hits and misses of each rule. Counting is off
+// until EnableStatistics() is called, and then the caller of a rule reports the
+// result with RecordResult(). The counters are not thread-safe.
+template <typename Rule>
+class FoldingRuleList {
+ public:
+  using const_iterator = typename std::vector<Rule>::const_iterator;
+
+  void push_back(Rule rule) {
+    rules_.push_back(std::move(rule));
+    if (counting_) stats_.emplace_back();
+  }
+
+  const_iterator begin() const { return rules_.begin(); }
+  const_iterator end() const { return rules_.end(); }
+  size_t size() const { return rules_.size(); }
+  bool empty() const { return rules_.empty(); }
+  const Rule& operator[](size_t index) const { return rules_[index]; }
+
+  // Starts counting the hits and misses of the rules.
+  void EnableStatistics() {
+    counting_ = true;
+    stats_.resize(rules_.size());
+  }
+
+  // Records whether the rule at |index| folded the instruction it was tried
+  // on. Does nothing unless statistics are enabled.
+  void RecordResult(size_t index, bool folded) const {
+    if (!counting_) return;
+    if (folded) {
+      ++stats_[index].hits;
+    } else {
+      ++stats_[index].misses;
+    }
+  }
+
+  // Returns the counts of each rule, or an empty vector if statistics are not
+  // enabled.
+  const std::vector<FoldingRuleStats>& stats() const { return stats_; }
+
+ private:
+  std::vector<Rule> rules_;
+  bool counting_ = false;
+  mutable std::vector<FoldingRuleStats> stats_;
+};
+
+// The folding rules for core instructions, indexed by opcode.
+//
+// Lookups index a dense array with the opcode instead of hashing it. The array
+// holds a 16-bit position into the lists of rules rather than the lists
+// themselves, so that the sparse high opcodes used by extensions only cost two
+// bytes per opcode.
+template <typename Rule>
+class OpcodeRuleTable {
+ public:
+  // Position 0 is the empty list returned for opcodes without rules.
+  OpcodeRuleTable() : lists_(1) {}
+
+  // Returns the rules for |opcode|, adding an empty list if there is none.
+  FoldingRuleList<Rule>& operator[](spv::Op opcode) {
+    const uint32_t op = static_cast<uint32_t>(opcode);
+    if (op >= index_.size()) index_.resize(op + 1, 0);
+    if (index_[op] == 0) {
+      assert(lists_.size() <= std::numeric_limits<uint16_t>::max() &&
+             "Too many opcodes with folding rules.");
+      index_[op] = static_cast<uint16_t>(lists_.size());
+      lists_.emplace_back();
+      if (counting_) lists_.back().EnableStatistics();
+    }
+    return lists_[index_[op]];
+  }
+
+  // Returns the rules for |opcode|, which may be empty.
+  const FoldingRuleList<Rule>& Find(spv::Op opcode) const {
+    const uint32_t op = static_cast<uint32_t>(opcode);
+    return lists_[op < index_.size() ? index_[op] : 0];
+  }
+
+  // Starts counting the hits and misses of every rule in the table.
+  void EnableStatistics() {
+    counting_ = true;
+    for (auto& list : lists_) list.EnableStatistics();
+  }
+
+  // Calls |f| with each opcode that has rules, in increasing order, and its
+  // rules.
+  template <typename Func>
+  void ForEach(Func f) const {
+    for (uint32_t op = 0; op < index_.size(); ++op) {
+      if (index_[op] != 0) f(static_cast<spv::Op>(op), lists_[index_[op]]);
+    }
+  }
+
+ private:
+  // |index_[opcode]| is the position in |lists_| of the rules for |opcode|, or
+  // 0 if it has none.
+  std::vector<uint16_t> index_;
+  std::vector<FoldingRuleList<Rule>> lists_;
+  bool counting_ = false;
+};
+
+// The folding rules for extended instructions, keyed by the id of the
+// extended instruction set import and the opcode within that set.
+//
+// There are few of them and they are looked up less often than core
+// instructions, so they are kept in a vector sorted by key.
+template <typename Rule>
+class ExtInstRuleTable {
+ public:
+  struct Key {
+    uint32_t instruction_set;
+    uint32_t opcode;
+
+    friend bool operator<(const Key& a, const Key& b) {
+      if (a.instruction_set != b.instruction_set) {
+        return a.instruction_set < b.instruction_set;
+      }
+      return a.opcode < b.opcode;
+    }
+  };
+
+  // Returns the rules for |key|, adding an empty list if there is none.
+  FoldingRuleList<Rule>& operator[](const Key& key) {
+    auto it = LowerBound(key);
+    if (it == entries_.end() || key < it->first) {
+      it = entries_.emplace(it, key, FoldingRuleList<Rule>());
+      if (counting_) it->second.EnableStatistics();
+    }
+    return it->second;
+  }
+
+  // Returns the rules for |opcode| of the instruction set imported as
+  // |instruction_set|, which may be empty.
+  const FoldingRuleList<Rule>& Find(uint32_t instruction_set,
+                                    uint32_t opcode) const {
+    const Key key{instruction_set, opcode};
+    auto it = LowerBound(key);
+    if (it == entries_.end() || key < it->first) return empty_;
+    return it->second;
+  }
+
+  // Starts counting the hits and misses of every rule in the table.
+  void EnableStatistics() {
+    counting_ = true;
+    for (auto& entry : entries_) entry.second.EnableStatistics();
+  }
+
+  // Calls |f| with each key that has rules, in increasing order, and its
+  // rules.
+  template <typename Func>
+  void ForEach(Func f) const {
+    for (const auto& entry : entries_) f(entry.first, entry.second);
+  }
+
+ private:
+  using Entry = std::pair<Key, FoldingRuleList<Rule>>;
+
+  typename std::vector<Entry>::iterator LowerBound(const Key& key) {
+    return std::lower_bound(
+        entries_.begin(), entries_.end(), key,
+        [](const Entry& entry, const Key& k) { return entry.first < k; });
+  }
+
+  typename std::vector<Entry>::const_iterator LowerBound(
+      const Key& key) const {
+    return std::lower_bound(
+        entries_.begin(), entries_.end(), key,
+        [](const Entry& entry, const Key& k) { return entry.first < k; });
+  }
+
+  std::vector<Entry> entries_;
+  FoldingRuleList<Rule> empty_;
+  bool counting_ = false;
+};
+
+// Writes the hits and misses of each rule in |rules| and |ext_rules| that was
+// tried at least once to |out|, one rule per line. Rules are named by their
+// opcode and their position in the list for that opcode.
+template <typename Rule>
+void PrintFoldingRuleStats(const OpcodeRuleTable<Rule>& rules,
+                           const ExtInstRuleTable<Rule>& ext_rules,
+                           std::ostream& out) {
+  auto print_list = [&out](const FoldingRuleList<Rule>& list) {
+    for (size_t i = 0; i < list.stats().size(); ++i) {
+      const FoldingRuleStats& stats = list.stats()[i];
+      if (stats.hits == 0 && stats.misses == 0) continue;
+      out << "  rule " << i << ": " << stats.hits << " hits, " << stats.misses
+          << " misses\n";
+    }
+  };
+  auto tried = [](const FoldingRuleList<Rule>& list) {
+    for (const FoldingRuleStats& stats : list.stats()) {
+      if (stats.hits != 0 || stats.misses != 0) return true;
+    }
+    return false;
+  };
+
+  rules.ForEach([&](spv::Op opcode, const FoldingRuleList<Rule>& list) {
+    if (!tried(list)) return;
+    out << "Op" << spvOpcodeString(opcode) << "\n";
+    print_list(list);
+  });
+  ext_rules.ForEach([&](const typename ExtInstRuleTable<Rule>::Key& key,
+                        const FoldingRuleList<Rule>& list) {
+    if (!tried(list)) return;
+    out << "OpExtInst %" << key.instruction_set << " " << key.opcode << "\n";
+    print_list(list);
+  });
+}
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_FOLDING_RULE_TABLE_H_
@@ -16,10 +16,12 @@
 #define SOURCE_OPT_FOLDING_RULES_H_
 
 #include <cstdint>
-#include <unordered_map>
+#include <functional>
+#include <ostream>
 #include <vector>
 
 #include "source/opt/constants.h"
+#include "source/opt/folding_rule_table.h"
 
 namespace spvtools {
 namespace opt {
@@ -58,26 +60,17 @@ using FoldingRule = std::function<bool(
 
 class FoldingRules {
  public:
-  using FoldingRuleSet = std::vector<FoldingRule>;
+  using FoldingRuleSet = FoldingRuleList<FoldingRule>;
 
   explicit FoldingRules(IRContext* ctx) : context_(ctx) {}
   virtual ~FoldingRules() = default;
 
   const FoldingRuleSet& GetRulesForInstruction(Instruction* inst) const {
     if (inst->opcode() != spv::Op::OpExtInst) {
-      auto it = rules_.find(inst->opcode());
-      if (it != rules_.end()) {
-        return it->second;
-      }
-    } else {
-      uint32_t ext_inst_id = inst->GetSingleWordInOperand(0);
-      uint32_t ext_opcode = inst->GetSingleWordInOperand(1);
-      auto it = ext_rules_.find({ext_inst_id, ext_opcode});
-      if (it != ext_rules_.end()) {
-        return it->second;
-      }
+      return rules_.Find(inst->opcode());
     }
-    return empty_vector_;
+    return ext_rules_.Find(inst->GetSingleWordInOperand(0),
+                           inst->GetSingleWordInOperand(1));
   }
 
   IRContext* context() { return context_; }
@@ -85,37 +78,26 @@ class FoldingRules {
   // Adds the folding rules for the object.
   virtual void AddFoldingRules();
 
- protected:
-  struct hasher {
-    size_t operator()(const spv::Op& op) const noexcept {
-      return std::hash<uint32_t>()(uint32_t(op));
-    }
-  };
+  // Starts counting the hits and misses of every rule.
+  void EnableStatistics() {
+    rules_.EnableStatistics();
+    ext_rules_.EnableStatistics();
+  }
+
+  // Writes the hits and misses of the rules that were tried to |out|.
+  void PrintStatistics(std::ostream& out) const {
+    PrintFoldingRuleStats(rules_, ext_rules_, out);
+  }
 
+ protected:
   // The folding rules for core instructions.
-  std::unordered_map<spv::Op, FoldingRuleSet, hasher> rules_;
+  OpcodeRuleTable<FoldingRule> rules_;
 
   // The folding rules for extended instructions.
-  struct Key {
-    uint32_t instruction_set;
-    uint32_t opcode;
-  };
-
-  friend bool operator<(const Key& a, const Key& b) {
-    if (a.instruction_set < b.instruction_set) {
-      return true;
-    }
-    if (a.instruction_set > b.instruction_set) {
-      return false;
-    }
-    return a.opcode < b.opcode;
-  }
-
-  std::map<Key, FoldingRuleSet> ext_rules_;
+  ExtInstRuleTable<FoldingRule> ext_rules_;
 
  private:
   IRContext* context_;
-  FoldingRuleSet empty_vector_;
 };
 
 }  // namespace opt
@@ -14,6 +14,7 @@
 
 #include "source/opt/instruction.h"
 
+#include <algorithm>
 #include <initializer_list>
 
 #include "OpenCLDebugInfo100.h"
@@ -205,9 +206,12 @@ bool Instruction::HasBranchWeights() const {
 void Instruction::ToBinaryWithoutAttachedDebugInsts(
     std::vector<uint32_t>* binary) const {
   const uint32_t num_words = 1 + NumOperandWords();
-  binary->push_back((num_words << 16) | static_cast<uint16_t>(opcode_));
+  const size_t start = binary->size();
+  binary->resize(start + num_words);
+  uint32_t* out = binary->data() + start;
+  *out++ = (num_words << 16) | static_cast<uint16_t>(opcode_);
   for (const auto& operand : operands_) {
-    binary->insert(binary->end(), operand.words.begin(), operand.words.end());
+    out = std::copy(operand.words.begin(), operand.words.end(), out);
   }
 }
 
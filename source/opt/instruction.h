@@ -31,6 +31,7 @@
 #include "source/opcode.h"
 #include "source/operand.h"
 #include "source/opt/reflect.h"
+#include "source/util/arena.h"
 #include "source/util/ilist_node.h"
 #include "source/util/small_vector.h"
 #include "source/util/string_utils.h"
@@ -179,7 +180,8 @@ class DebugScope {
 // appearing before this instruction. Note that the result id of an instruction
 // should never change after the instruction being built. If the result id
 // needs to change, the user should create a new instruction instead.
-class Instruction : public utils::IntrusiveNodeBase<Instruction> {
+class Instruction : public utils::IntrusiveNodeBase<Instruction>,
+                    public utils::ArenaObject {
  public:
   using OperandList = std::vector<Operand>;
   using iterator = OperandList::iterator;
@@ -809,7 +811,8 @@ inline void Instruction::ForEachId(
 
 inline bool Instruction::WhileEachInId(
     const std::function<bool(uint32_t*)>& f) {
-  for (auto& operand : operands_) {
+  for (uint32_t i = TypeResultIdCount(); i < operands_.size(); ++i) {
+    Operand& operand = operands_[i];
     if (spvIsInIdType(operand.type) && !f(&operand.words[0])) {
       return false;
     }
@@ -819,7 +822,8 @@ inline bool Instruction::WhileEachInId(
 
 inline bool Instruction::WhileEachInId(
     const std::function<bool(const uint32_t*)>& f) const {
-  for (const auto& operand : operands_) {
+  for (uint32_t i = TypeResultIdCount(); i < operands_.size(); ++i) {
+    const Operand& operand = operands_[i];
     if (spvIsInIdType(operand.type) && !f(&operand.words[0])) {
       return false;
     }
@@ -844,7 +848,8 @@ inline void Instruction::ForEachInId(
 
 inline bool Instruction::WhileEachInOperand(
     const std::function<bool(uint32_t*)>& f) {
-  for (auto& operand : operands_) {
+  for (uint32_t i = TypeResultIdCount(); i < operands_.size(); ++i) {
+    Operand& operand = operands_[i];
     switch (operand.type) {
       case SPV_OPERAND_TYPE_RESULT_ID:
       case SPV_OPERAND_TYPE_TYPE_ID:
@@ -859,7 +864,8 @@ inline bool Instruction::WhileEachInOperand(
 
 inline bool Instruction::WhileEachInOperand(
     const std::function<bool(const uint32_t*)>& f) const {
-  for (const auto& operand : operands_) {
+  for (uint32_t i = TypeResultIdCount(); i < operands_.size(); ++i) {
+    const Operand& operand = operands_[i];
     switch (operand.type) {
       case SPV_OPERAND_TYPE_RESULT_ID:
       case SPV_OPERAND_TYPE_TYPE_ID:
@@ -39,6 +39,9 @@ constexpr uint32_t kDebugFunctionOperandFunctionIndex = 13;
 constexpr uint32_t kDebugGlobalVariableOperandVariableIndex = 11;
 }  // namespace
 
+static_assert(IRContext::kAnalysisEnd == 1u << AnalysisReport::kNumAnalyses,
+              "The analysis report must have an entry for every analysis.");
+
 void IRContext::BuildInvalidAnalyses(IRContext::Analysis set) {
   set = Analysis(set & ~valid_analyses_);
 
@@ -120,6 +123,11 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
     analyses_to_invalidate |= kAnalysisDominatorAnalysis;
   }
 
+  if (analysis_report_ != nullptr) {
+    analysis_report_->RecordInvalidation(analyses_to_invalidate &
+                                         valid_analyses_);
+  }
+
   if (analyses_to_invalidate & kAnalysisDefUse) {
     def_use_mgr_.reset(nullptr);
   }
@@ -812,6 +820,7 @@ void IRContext::AddCombinatorsForExtension(Instruction* extension) {
 }
 
 void IRContext::InitializeCombinators() {
+  AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisCombinators);
   for (auto capability : get_feature_mgr()->GetCapabilities()) {
     AddCombinatorsForCapability(uint32_t(capability));
   }
@@ -844,6 +853,7 @@ LoopDescriptor* IRContext::GetLoopDescriptor(const Function* f) {
   std::unordered_map<const Function*, LoopDescriptor>::iterator it =
       loop_descriptors_.find(f);
   if (it == loop_descriptors_.end()) {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisLoopAnalysis);
     return &loop_descriptors_
                 .emplace(std::make_pair(f, LoopDescriptor(this, f)))
                 .first->second;
@@ -1112,7 +1122,10 @@ DominatorAnalysis* IRContext::GetDominatorAnalysis(const Function* f) {
   }
 
   if (dominator_trees_.find(f) == dominator_trees_.end()) {
-    dominator_trees_[f].InitializeTree(*cfg(), f);
+    const CFG* cfg_analysis = cfg();
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisDominatorAnalysis);
+    dominator_trees_[f].InitializeTree(*cfg_analysis, f);
   }
 
   return &dominator_trees_[f];
@@ -1125,12 +1138,29 @@ PostDominatorAnalysis* IRContext::GetPostDominatorAnalysis(const Function* f) {
   }
 
   if (post_dominator_trees_.find(f) == post_dominator_trees_.end()) {
-    post_dominator_trees_[f].InitializeTree(*cfg(), f);
+    const CFG* cfg_analysis = cfg();
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisDominatorAnalysis);
+    post_dominator_trees_[f].InitializeTree(*cfg_analysis, f);
   }
 
   return &post_dominator_trees_[f];
 }
 
+void IRContext::UpdateDominatorsForMergedBlocks(const Function* f,
+                                                BasicBlock* pred,
+                                                BasicBlock* succ) {
+  if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) return;
+  auto dom = dominator_trees_.find(f);
+  if (dom != dominator_trees_.end()) {
+    dom->second.MergeBlocks(pred, succ);
+  }
+  auto post_dom = post_dominator_trees_.find(f);
+  if (post_dom != post_dominator_trees_.end()) {
+    post_dom->second.MergeBlocks(pred, succ);
+  }
+}
+
 bool IRContext::CheckCFG() {
   std::unordered_map<uint32_t, std::vector<uint32_t>> real_preds;
   if (!AreAnalysesValid(kAnalysisCFG)) {
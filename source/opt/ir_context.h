@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "source/assembly_grammar.h"
+#include "source/opt/analysis_report.h"
 #include "source/opt/cfg.h"
 #include "source/opt/constants.h"
 #include "source/opt/debug_info_manager.h"
@@ -44,6 +45,7 @@
 #include "source/opt/type_manager.h"
 #include "source/opt/value_number_table.h"
 #include "source/table2.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 #include "source/util/string_utils.h"
 
@@ -111,7 +113,8 @@ class IRContext {
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
         preserve_spec_constants_(false),
-        id_overflow_(false) {
+        id_overflow_(false),
+        analysis_report_(nullptr) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
   }
@@ -130,7 +133,8 @@ class IRContext {
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
         preserve_spec_constants_(false),
-        id_overflow_(false) {
+        id_overflow_(false),
+        analysis_report_(nullptr) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
     InitializeCombinators();
@@ -140,6 +144,10 @@ class IRContext {
 
   Module* module() const { return module_.get(); }
 
+  // Returns the arena for the IR of this context. Code that builds or
+  // transforms the module activates it with a utils::ArenaScope.
+  utils::Arena* arena() { return &arena_; }
+
   // Returns a vector of pointers to constant-creation instructions in this
   // context.
   inline std::vector<Instruction*> GetConstants();
@@ -554,6 +562,14 @@ class IRContext {
   // Gets the postdominator analysis for function |f|.
   PostDominatorAnalysis* GetPostDominatorAnalysis(const Function* f);
 
+  // Sets the report that records the invalidations and builds of analyses.
+  // Passing nullptr stops recording. The context does not take ownership of
+  // |report|.
+  void SetAnalysisReport(AnalysisReport* report) { analysis_report_ = report; }
+
+  // Returns the report set with SetAnalysisReport(), or nullptr.
+  AnalysisReport* analysis_report() const { return analysis_report_; }
+
   // Remove the dominator tree of |f| from the cache.
   inline void RemoveDominatorAnalysis(const Function* f) {
     dominator_trees_.erase(f);
@@ -564,6 +580,12 @@ class IRContext {
     post_dominator_trees_.erase(f);
   }
 
+  // Updates the dominator and postdominator trees of |f| after |succ| has
+  // been merged into |pred|, its only predecessor. Must be called while both
+  // blocks still have their labels.
+  void UpdateDominatorsForMergedBlocks(const Function* f, BasicBlock* pred,
+                                       BasicBlock* succ);
+
   // Return the next available SSA id and increment it.  Returns 0 if the
   // maximum SSA id has been reached.
   inline uint32_t TakeNextId() {
@@ -718,18 +740,22 @@ class IRContext {
  private:
   // Builds the def-use manager from scratch, even if it was already valid.
   void BuildDefUseManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisDefUse);
     def_use_mgr_ = MakeUnique<analysis::DefUseManager>(module());
     valid_analyses_ = valid_analyses_ | kAnalysisDefUse;
   }
 
   // Builds the liveness manager from scratch, even if it was already valid.
   void BuildLivenessManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisLiveness);
     liveness_mgr_ = MakeUnique<analysis::LivenessManager>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisLiveness;
   }
 
   // Builds the instruction-block map for the whole module.
   void BuildInstrToBlockMapping() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisInstrToBlockMapping);
     instr_to_block_.clear();
     for (auto& fn : *module_) {
       for (auto& block : fn) {
@@ -743,6 +769,8 @@ class IRContext {
 
   // Builds the instruction-function map for the whole module.
   void BuildIdToFuncMapping() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisIdToFuncMapping);
     id_to_func_.clear();
     for (auto& fn : *module_) {
       id_to_func_[fn.result_id()] = &fn;
@@ -752,6 +780,8 @@ class IRContext {
 
   // Builds the instruction-graph map for the whole module.
   void BuildIdToGraphMapping() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisIdToGraphMapping);
     id_to_graph_.clear();
     for (auto& g : module_->graphs()) {
       id_to_graph_[g->DefInst().result_id()] = g.get();
@@ -760,22 +790,28 @@ class IRContext {
   }
 
   void BuildDecorationManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisDecorations);
     decoration_mgr_ = MakeUnique<analysis::DecorationManager>(module());
     valid_analyses_ = valid_analyses_ | kAnalysisDecorations;
   }
 
   void BuildCFG() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisCFG);
     cfg_ = MakeUnique<CFG>(module());
     valid_analyses_ = valid_analyses_ | kAnalysisCFG;
   }
 
   void BuildScalarEvolutionAnalysis() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisScalarEvolution);
     scalar_evolution_analysis_ = MakeUnique<ScalarEvolutionAnalysis>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisScalarEvolution;
   }
 
   // Builds the liveness analysis from scratch, even if it was already valid.
   void BuildRegPressureAnalysis() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisRegisterPressure);
     reg_pressure_ = MakeUnique<LivenessAnalysis>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisRegisterPressure;
   }
@@ -783,6 +819,8 @@ class IRContext {
   // Builds the value number table analysis from scratch, even if it was already
   // valid.
   void BuildValueNumberTable() {
+    AnalysisReport::ScopedBuild scope(analysis_report_,
+                                      kAnalysisValueNumberTable);
     vn_table_ = MakeUnique<ValueNumberTable>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisValueNumberTable;
   }
@@ -790,6 +828,7 @@ class IRContext {
   // Builds the structured CFG analysis from scratch, even if it was already
   // valid.
   void BuildStructuredCFGAnalysis() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisStructuredCFG);
     struct_cfg_analysis_ = MakeUnique<StructuredCFGAnalysis>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisStructuredCFG;
   }
@@ -797,6 +836,7 @@ class IRContext {
   // Builds the constant manager from scratch, even if it was already
   // valid.
   void BuildConstantManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisConstants);
     constant_mgr_ = MakeUnique<analysis::ConstantManager>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisConstants;
   }
@@ -804,6 +844,7 @@ class IRContext {
   // Builds the type manager from scratch, even if it was already
   // valid.
   void BuildTypeManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisTypes);
     type_mgr_ = MakeUnique<analysis::TypeManager>(consumer(), this);
     valid_analyses_ = valid_analyses_ | kAnalysisTypes;
   }
@@ -811,6 +852,7 @@ class IRContext {
   // Builds the debug information manager from scratch, even if it was
   // already valid.
   void BuildDebugInfoManager() {
+    AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisDebugInfo);
     debug_info_mgr_ = MakeUnique<analysis::DebugInfoManager>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisDebugInfo;
   }
@@ -883,6 +925,12 @@ class IRContext {
   // Therefore, 0 is not a valid unique id for an instruction.
   uint32_t unique_id_;
 
+  // The arena that instructions and blocks created while loading or
+  // optimizing |module_| are allocated from, when the library is built with
+  // SPIRV_OPT_USE_ARENA. It is declared before |module_| and the analyses so
+  // that it outlives everything allocated from it.
+  utils::Arena arena_;
+
   // The module being processed within this IR context.
   std::unique_ptr<Module> module_;
 
@@ -980,6 +1028,10 @@ class IRContext {
 
   // Set to true if TakeNextId() fails.
   bool id_overflow_;
+
+  // The report that analysis invalidations and builds are recorded in, if
+  // any. Not owned by the context.
+  AnalysisReport* analysis_report_;
 };
 
 inline IRContext::Analysis operator|(IRContext::Analysis lhs,
@@ -1293,6 +1345,7 @@ void IRContext::UpdateDefUse(Instruction* inst) {
 }
 
 void IRContext::BuildIdToNameMap() {
+  AnalysisReport::ScopedBuild scope(analysis_report_, kAnalysisNameMap);
   id_to_name_ = MakeUnique<std::multimap<uint32_t, Instruction*>>();
   for (Instruction& debug_inst : debugs2()) {
     if (debug_inst.opcode() == spv::Op::OpMemberName ||
@@ -150,6 +150,7 @@ void Module::ForEachInst(const std::function<void(const Instruction*)>& f,
 }
 
 void Module::ToBinary(std::vector<uint32_t>* binary, bool skip_nop) const {
+  binary->reserve(binary->size() + ComputeBinarySize());
   binary->push_back(header_.magic_number);
   binary->push_back(header_.version);
   // TODO(antiagainst): should we change the generator number?
@@ -251,6 +252,14 @@ void Module::ToBinary(std::vector<uint32_t>* binary, bool skip_nop) const {
   binary->data()[bound_idx] = header_.bound;
 }
 
+size_t Module::ComputeBinarySize() const {
+  size_t size = 5;  // The header.
+  ForEachInst(
+      [&size](const Instruction* inst) { size += 1 + inst->NumOperandWords(); },
+      true /* count debug line insts as well */);
+  return size;
+}
+
 uint32_t Module::ComputeIdBound() const {
   uint32_t highest = 0;
 
@@ -279,6 +279,10 @@ class Module {
   // If |skip_nop| is true and this is a OpNop, do nothing.
   void ToBinary(std::vector<uint32_t>* binary, bool skip_nop) const;
 
+  // Returns the number of words |ToBinary| writes for this module, not
+  // counting the debug scope and line instructions that it synthesizes.
+  size_t ComputeBinarySize() const;
+
   // Returns 1 more than the maximum Id value mentioned in the module.
   uint32_t ComputeIdBound() const;
 
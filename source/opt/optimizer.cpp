@@ -28,6 +28,7 @@
 #include "source/opt/log.h"
 #include "source/opt/pass_manager.h"
 #include "source/opt/passes.h"
+#include "source/opt/profiler.h"
 #include "source/spirv_optimizer_options.h"
 #include "source/util/make_unique.h"
 #include "source/util/string_utils.h"
@@ -72,6 +73,8 @@ struct Optimizer::Impl {
   spv_target_env target_env;      // Target environment.
   opt::PassManager pass_manager;  // Internal implementation pass manager.
   std::unordered_set<uint32_t> live_locs;  // Arg to debug dead output passes
+  std::ostream* profile_stream = nullptr;  // Output of the pass profile.
+  std::ostream* trace_stream = nullptr;    // Output of the trace events.
 };
 
 Optimizer::Optimizer(spv_target_env env) : impl_(new Impl(env)) {
@@ -657,6 +660,48 @@ void Optimizer::SetTargetEnv(const spv_target_env env) {
   impl_->target_env = env;
 }
 
+namespace {
+
+// Profiles an Optimizer::Run() for as long as the scope lives, if
+// |profile_out| or |trace_out| is not null, and then writes the pass profile
+// to |profile_out| and the trace events to |trace_out|.
+class ScopedRunProfile {
+ public:
+  ScopedRunProfile(opt::PassManager* pass_manager, std::ostream* profile_out,
+                   std::ostream* trace_out)
+      : pass_manager_(pass_manager),
+        profile_out_(profile_out),
+        trace_out_(trace_out),
+        profiler_(trace_out != nullptr),
+        start_(opt::Profiler::Clock::now()) {
+    if (profiler() != nullptr) pass_manager_->SetProfiler(&profiler_);
+  }
+
+  ~ScopedRunProfile() {
+    if (profiler() == nullptr) return;
+    pass_manager_->SetProfiler(nullptr);
+    profiler_.AddEvent("Optimizer::Run", "optimizer", start_,
+                       opt::Profiler::Clock::now());
+    if (profile_out_ != nullptr) profiler_.WriteJson(*profile_out_);
+    if (trace_out_ != nullptr) profiler_.WriteTrace(*trace_out_);
+  }
+
+  // Returns the profiler, or null if nothing is profiled.
+  opt::Profiler* profiler() {
+    return (profile_out_ != nullptr || trace_out_ != nullptr) ? &profiler_
+                                                              : nullptr;
+  }
+
+ private:
+  opt::PassManager* pass_manager_;
+  std::ostream* profile_out_;
+  std::ostream* trace_out_;
+  opt::Profiler profiler_;
+  opt::Profiler::Clock::time_point start_;
+};
+
+}  // namespace
+
 bool Optimizer::Run(const uint32_t* original_binary,
                     const size_t original_binary_size,
                     std::vector<uint32_t>* optimized_binary) const {
@@ -680,16 +725,26 @@ bool Optimizer::Run(const uint32_t* original_binary,
                     const size_t original_binary_size,
                     std::vector<uint32_t>* optimized_binary,
                     const spv_optimizer_options opt_options) const {
+  ScopedRunProfile run_profile(&impl_->pass_manager, impl_->profile_stream,
+                               impl_->trace_stream);
   spvtools::SpirvTools tools(impl_->target_env);
   tools.SetMessageConsumer(impl_->pass_manager.consumer());
-  if (opt_options->run_validator_ &&
-      !tools.Validate(original_binary, original_binary_size,
-                      &opt_options->val_options_)) {
-    return false;
+  if (opt_options->run_validator_) {
+    opt::Profiler::ScopedEvent event(run_profile.profiler(), "Validate",
+                                     "validate");
+    if (!tools.Validate(original_binary, original_binary_size,
+                        &opt_options->val_options_)) {
+      return false;
+    }
   }
 
-  std::unique_ptr<opt::IRContext> context = BuildModule(
-      impl_->target_env, consumer(), original_binary, original_binary_size);
+  std::unique_ptr<opt::IRContext> context;
+  {
+    opt::Profiler::ScopedEvent event(run_profile.profiler(), "BuildModule",
+                                     "parse");
+    context = BuildModule(impl_->target_env, consumer(), original_binary,
+                          original_binary_size);
+  }
   if (context == nullptr) return false;
 
   context->set_max_id_bound(opt_options->max_id_bound_);
@@ -735,6 +790,8 @@ bool Optimizer::Run(const uint32_t* original_binary,
   // Note that |original_binary| and |optimized_binary| may share the same
   // buffer and the below will invalidate |original_binary|.
   optimized_binary->clear();
+  opt::Profiler::ScopedEvent event(run_profile.profiler(), "ToBinary",
+                                   "serialize");
   context->module()->ToBinary(optimized_binary, /* skip_nop = */ true);
 
   return true;
@@ -750,6 +807,21 @@ Optimizer& Optimizer::SetTimeReport(std::ostream* out) {
   return *this;
 }
 
+Optimizer& Optimizer::SetAnalysisReport(std::ostream* out) {
+  impl_->pass_manager.SetAnalysisReport(out);
+  return *this;
+}
+
+Optimizer& Optimizer::SetProfileReport(std::ostream* out) {
+  impl_->profile_stream = out;
+  return *this;
+}
+
+Optimizer& Optimizer::SetTraceReport(std::ostream* out) {
+  impl_->trace_stream = out;
+  return *this;
+}
+
 Optimizer& Optimizer::SetValidateAfterAll(bool validate) {
   impl_->pass_manager.SetValidateAfterAll(validate);
   return *this;
@@ -15,19 +15,71 @@
 #include "source/opt/pass_manager.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "source/opt/analysis_report.h"
 #include "source/opt/ir_context.h"
+#include "source/opt/profiler.h"
+#include "source/spirv_validator_options.h"
+#include "source/util/arena.h"
+#include "source/util/make_unique.h"
 #include "source/util/timer.h"
+#include "source/val/function_check_cache.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
 
 namespace opt {
+namespace {
+
+// Records the analysis builds of |context| in a new report while the scope
+// lives, and then writes the report to |out| if that is not null. If
+// |profiler| records a trace, the builds are also traced there. Does nothing
+// if there is neither an output nor a trace.
+class ScopedAnalysisReport {
+ public:
+  ScopedAnalysisReport(IRContext* context, std::ostream* out,
+                       Profiler* profiler)
+      : context_(context),
+        out_(out),
+        active_(out != nullptr ||
+                (profiler != nullptr && profiler->records_trace())),
+        previous_(context->analysis_report()) {
+    if (!active_) return;
+    if (profiler != nullptr && profiler->records_trace()) {
+      report_.SetProfiler(profiler);
+    }
+    context_->SetAnalysisReport(&report_);
+  }
+  ~ScopedAnalysisReport() {
+    if (!active_) return;
+    context_->SetAnalysisReport(previous_);
+    if (out_ != nullptr) report_.Print(*out_);
+  }
+
+  // Starts recording against |pass|.
+  void BeginPass(const Pass& pass) {
+    if (active_) report_.BeginPass(pass.name());
+  }
+
+ private:
+  IRContext* context_;
+  std::ostream* out_;
+  bool active_;
+  AnalysisReport* previous_;
+  AnalysisReport report_;
+};
+
+}  // namespace
 
 Pass::Status PassManager::Run(IRContext* context) {
   auto status = Pass::Status::SuccessWithoutChange;
+  Profiler::ScopedEvent run_event(profiler_, "PassManager::Run", "optimizer");
+  utils::ArenaScope arena_scope(context->arena());
+  ScopedAnalysisReport analysis_report(context, analysis_report_stream_,
+                                       profiler_);
 
   // If print_all_stream_ is not null, prints the disassembly of the module
   // to that stream, with the given preamble and optionally the pass name.
@@ -51,20 +103,50 @@ Pass::Status PassManager::Run(IRContext* context) {
     }
   };
 
+  // State for validate-after-all, shared by all passes. The module is
+  // validated after every pass, whatever status the pass reports, since the
+  // point is to catch passes that break the module or misreport their status.
+  // |function_check_cache| lets the validator skip the control flow checks of
+  // functions whose instructions did not change.
+  std::unique_ptr<SpirvTools> validator;
+  std::vector<uint32_t> validation_binary;
+  val::FunctionCheckCache function_check_cache;
+  spv_validator_options_t validation_options;
+  if (validate_after_all_) {
+    validator = MakeUnique<SpirvTools>(target_env_);
+    validator->SetMessageConsumer(consumer());
+    if (val_options_) validation_options = *val_options_;
+    validation_options.function_check_cache = &function_check_cache;
+  }
+
   SPIRV_TIMER_DESCRIPTION(time_report_stream_, /* measure_mem_usage = */ true);
   for (auto& pass : passes_) {
     print_disassembly("; IR before pass ", pass.get());
     SPIRV_TIMER_SCOPED(time_report_stream_, (pass ? pass->name() : ""), true);
+    analysis_report.BeginPass(*pass);
+    if (profiler_) profiler_->BeginPass(pass->name(), *context->module());
     const auto one_status = pass->Run(context);
+    if (profiler_) {
+      profiler_->EndPass(one_status == Pass::Status::SuccessWithChange,
+                         *context->module());
+    }
     if (one_status == Pass::Status::Failure) return one_status;
     if (one_status == Pass::Status::SuccessWithChange) status = one_status;
 
-    if (validate_after_all_) {
-      spvtools::SpirvTools tools(target_env_);
-      tools.SetMessageConsumer(consumer());
-      std::vector<uint32_t> binary;
-      context->module()->ToBinary(&binary, true);
-      if (!tools.Validate(binary.data(), binary.size(), val_options_)) {
+    if (validator) {
+      validation_binary.clear();
+      {
+        Profiler::ScopedEvent event(profiler_, "ToBinary", "serialize");
+        context->module()->ToBinary(&validation_binary, true);
+      }
+      bool valid;
+      {
+        Profiler::ScopedEvent event(profiler_, "Validate", "validate");
+        valid = validator->Validate(validation_binary.data(),
+                                    validation_binary.size(),
+                                    &validation_options);
+      }
+      if (!valid) {
         std::string msg = "Validation failed after pass ";
         msg += pass->name();
         spv_position_t null_pos{0, 0, 0};
@@ -25,6 +25,7 @@
 #include "source/opt/pass.h"
 
 #include "source/opt/ir_context.h"
+#include "source/opt/profiler.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
@@ -44,6 +45,8 @@ class PassManager {
       : consumer_(nullptr),
         print_all_stream_(nullptr),
         time_report_stream_(nullptr),
+        analysis_report_stream_(nullptr),
+        profiler_(nullptr),
         target_env_(SPV_ENV_UNIVERSAL_1_2),
         val_options_(nullptr),
         validate_after_all_(false) {}
@@ -92,6 +95,24 @@ class PassManager {
     return *this;
   }
 
+  // Sets the option to report, for each pass, the analyses it invalidated and
+  // the cost of the analyses built while it ran. Output is written to |out|
+  // after the last pass if that is not null. No output is generated if |out|
+  // is null.
+  PassManager& SetAnalysisReport(std::ostream* out) {
+    analysis_report_stream_ = out;
+    return *this;
+  }
+
+  // Sets the profiler that records the cost of each pass and, if it records a
+  // trace, trace events for the run, each pass, analysis builds, and the
+  // serialization and validation done by SetValidateAfterAll(). Passing null
+  // stops profiling. The pass manager does not take ownership of |profiler|.
+  PassManager& SetProfiler(Profiler* profiler) {
+    profiler_ = profiler;
+    return *this;
+  }
+
   // Sets the target environment for validation.
   PassManager& SetTargetEnv(spv_target_env env) {
     target_env_ = env;
@@ -104,7 +125,10 @@ class PassManager {
     return *this;
   }
 
-  // Sets the option to validate after each pass.
+  // Sets the option to validate after each pass. The module is validated
+  // after every pass, whatever status the pass reports. The control flow and
+  // dominance checks are only redone for the functions whose instructions
+  // changed since the last validation.
   PassManager& SetValidateAfterAll(bool validate) {
     validate_after_all_ = validate;
     return *this;
@@ -121,6 +145,11 @@ class PassManager {
   // The output stream to write the resource utilization of each pass. If this
   // is null, no output is generated.
   std::ostream* time_report_stream_;
+  // The output stream to write the analysis report to. If this is null, no
+  // report is recorded.
+  std::ostream* analysis_report_stream_;
+  // The profiler to record passes in, or null. Not owned.
+  Profiler* profiler_;
   // The target environment.
   spv_target_env target_env_;
   // The validator options (used when validating each pass).
@@ -0,0 +1,246 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/profiler.h"
+
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+
+#include "source/opt/module.h"
+
+#if defined(SPIRV_TIMER_ENABLED)
+#include <sys/resource.h>
+#endif
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// Sets |max_rss_kb| and |page_faults| to the peak resident set size and the
+// number of page faults of the process so far, or to -1 if they are not
+// known.
+void GetMemoryUsage(long* max_rss_kb, long* page_faults) {
+  *max_rss_kb = -1;
+  *page_faults = -1;
+#if defined(SPIRV_TIMER_ENABLED)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    *max_rss_kb = usage.ru_maxrss;
+    *page_faults = usage.ru_minflt + usage.ru_majflt;
+  }
+#endif
+}
+
+// Returns |after| - |before|, or -1 if either is unknown.
+long Delta(long before, long after) {
+  return (before < 0 || after < 0) ? -1 : after - before;
+}
+
+// Writes |str| to |out| as a JSON string.
+void WriteJsonString(std::ostream& out, const std::string& str) {
+  out << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out << escaped;
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+// The JSON keys of the hardware counters, indexed by utils::PerfCounter.
+const char* const kPerfCounterKeys[utils::kNumPerfCounters] = {
+    "cycles", "instructions", "cache_misses", "branch_misses"};
+
+// Writes |value| to |out| as a JSON number, or null if it is -1.
+void WriteJsonCount(std::ostream& out, long long value) {
+  if (value < 0) {
+    out << "null";
+  } else {
+    out << value;
+  }
+}
+
+// Writes |seconds| to |out| as a JSON number, or null if it is negative.
+void WriteJsonSeconds(std::ostream& out, double seconds) {
+  if (seconds < 0) {
+    out << "null";
+  } else {
+    out << seconds;
+  }
+}
+
+void WriteJsonModuleSize(std::ostream& out,
+                         const Profiler::ModuleSize& size) {
+  out << "{\"functions\": " << size.functions
+      << ", \"blocks\": " << size.blocks
+      << ", \"instructions\": " << size.instructions << "}";
+}
+
+}  // namespace
+
+Profiler::ScopedEvent::ScopedEvent(Profiler* profiler, const char* name,
+                                   const char* category)
+    : profiler_(profiler != nullptr && profiler->records_trace() ? profiler
+                                                                 : nullptr),
+      name_(name),
+      category_(category) {
+  if (profiler_ != nullptr) start_ = Clock::now();
+}
+
+Profiler::ScopedEvent::~ScopedEvent() {
+  if (profiler_ == nullptr) return;
+  profiler_->AddEvent(name_, category_, start_, Clock::now());
+}
+
+Profiler::Profiler(bool record_trace)
+    : record_trace_(record_trace), origin_(Clock::now()) {
+  if (utils::PerfCountersBuiltIn()) {
+    perf_counters_.reset(new utils::PerfCounters());
+  }
+}
+
+void Profiler::BeginPass(const char* name, const Module& module) {
+  passes_.emplace_back();
+  passes_.back().name = name;
+  passes_.back().before = Measure(module);
+  GetMemoryUsage(&pass_start_.max_rss_kb, &pass_start_.page_faults);
+  pass_start_.cpu = std::clock();
+  pass_start_.wall = Clock::now();
+  if (perf_counters_) perf_counters_->Start();
+}
+
+void Profiler::EndPass(bool changed, const Module& module) {
+  if (perf_counters_) perf_counters_->Stop();
+  const Clock::time_point wall = Clock::now();
+  const std::clock_t cpu = std::clock();
+  long max_rss_kb;
+  long page_faults;
+  GetMemoryUsage(&max_rss_kb, &page_faults);
+
+  PassRecord& record = passes_.back();
+  record.changed = changed;
+  record.wall_seconds =
+      std::chrono::duration<double>(wall - pass_start_.wall).count();
+  record.cpu_seconds =
+      (cpu == std::clock_t(-1) || pass_start_.cpu == std::clock_t(-1))
+          ? -1
+          : static_cast<double>(cpu - pass_start_.cpu) / CLOCKS_PER_SEC;
+  record.peak_rss_growth_kb = Delta(pass_start_.max_rss_kb, max_rss_kb);
+  record.page_faults = Delta(pass_start_.page_faults, page_faults);
+  if (perf_counters_) {
+    for (int i = 0; i < utils::kNumPerfCounters; ++i) {
+      record.perf_counts[i] = perf_counters_->Count(utils::PerfCounter(i));
+    }
+  }
+  record.after = Measure(module);
+  if (record_trace_) AddEvent(record.name, "pass", pass_start_.wall, wall);
+}
+
+void Profiler::AddEvent(const std::string& name, const char* category,
+                        Clock::time_point start, Clock::time_point end) {
+  if (!record_trace_) return;
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  events_.push_back({name, category, Microseconds(start - origin_).count(),
+                     Microseconds(end - start).count()});
+}
+
+void Profiler::WriteJson(std::ostream& out) const {
+  const auto old_flags = out.flags();
+  const auto old_precision = out.precision(6);
+  out << std::fixed;
+
+  out << "{\n  \"passes\": [";
+  for (size_t i = 0; i < passes_.size(); ++i) {
+    const PassRecord& record = passes_[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    WriteJsonString(out, record.name);
+    out << ", \"changed\": " << (record.changed ? "true" : "false")
+        << ", \"wall_seconds\": " << record.wall_seconds
+        << ", \"cpu_seconds\": ";
+    WriteJsonSeconds(out, record.cpu_seconds);
+    out << ", \"peak_rss_growth_kb\": ";
+    WriteJsonCount(out, record.peak_rss_growth_kb);
+    out << ", \"page_faults\": ";
+    WriteJsonCount(out, record.page_faults);
+    out << ",\n     \"hw_counters\": {";
+    for (int c = 0; c < utils::kNumPerfCounters; ++c) {
+      out << (c == 0 ? "\"" : ", \"") << kPerfCounterKeys[c] << "\": ";
+      WriteJsonCount(out, record.perf_counts[c]);
+    }
+    out << "}";
+    out << ",\n     \"before\": ";
+    WriteJsonModuleSize(out, record.before);
+    out << ", \"after\": ";
+    WriteJsonModuleSize(out, record.after);
+    out << "}";
+  }
+  out << (passes_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+void Profiler::WriteTrace(std::ostream& out) const {
+  const auto old_flags = out.flags();
+  const auto old_precision = out.precision(3);
+  out << std::fixed;
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const Event& event = events_[i];
+    out << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+    WriteJsonString(out, event.name);
+    out << ", \"cat\": \"" << event.category
+        << "\", \"ph\": \"X\", \"ts\": " << event.start_us
+        << ", \"dur\": " << event.duration_us << ", \"pid\": 1, \"tid\": 1}";
+  }
+  out << "\n]}\n";
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+Profiler::ModuleSize Profiler::Measure(const Module& module) {
+  ModuleSize size;
+  for (const Function& function : module) {
+    ++size.functions;
+    size.blocks += static_cast<uint32_t>(
+        std::distance(function.begin(), function.end()));
+  }
+  module.ForEachInst([&size](const Instruction*) { ++size.instructions; });
+  return size;
+}
+
+}  // namespace opt
+}  // namespace spvtools
@@ -0,0 +1,154 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_PROFILER_H_
+#define SOURCE_OPT_PROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/util/perf_counters.h"
+
+namespace spvtools {
+namespace opt {
+
+class Module;
+
+// Collects machine-readable profiling data for an optimizer run: a record of
+// the cost of each pass and of how it changed the size of the module, and
+// optionally a timeline of trace events for the run, the passes, analysis
+// builds, validation and serialization.
+//
+// The records are written as JSON with WriteJson(), and the trace events in
+// the Chrome trace event format with WriteTrace(), which chrome://tracing and
+// Perfetto can load.
+//
+// A profiler is not thread-safe. Events must be recorded from one thread.
+class Profiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // The number of functions, basic blocks and instructions in a module.
+  struct ModuleSize {
+    uint32_t functions = 0;
+    uint32_t blocks = 0;
+    uint32_t instructions = 0;
+  };
+
+  // The cost of one pass.
+  struct PassRecord {
+    std::string name;
+    bool changed = false;
+    double wall_seconds = 0;
+    // The processor time of the pass, or -1 if std::clock() failed.
+    double cpu_seconds = 0;
+    // How much the peak resident set size of the process grew while the pass
+    // ran, in kilobytes. This is not the change in memory in use: it is 0 for
+    // a pass that stays below a peak reached earlier in the process.
+    long peak_rss_growth_kb = -1;
+    // The number of page faults while the pass ran. This and
+    // |peak_rss_growth_kb| are -1 if the platform does not report them.
+    long page_faults = -1;
+    // The hardware events of the pass, indexed by utils::PerfCounter. Each is
+    // -1 if the counter is not available (see utils::PerfCounters).
+    long long perf_counts[utils::kNumPerfCounters] = {-1, -1, -1, -1};
+    ModuleSize before;
+    ModuleSize after;
+  };
+
+  // Records a trace event that lasts as long as the scope. Does nothing if
+  // |profiler| is null or does not record a trace. |name| and |category| must
+  // outlive the scope.
+  class ScopedEvent {
+   public:
+    ScopedEvent(Profiler* profiler, const char* name, const char* category);
+    ~ScopedEvent();
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+   private:
+    Profiler* profiler_;
+    const char* name_;
+    const char* category_;
+    Clock::time_point start_;
+  };
+
+  // Creates a profiler. Trace events are only recorded if |record_trace| is
+  // true.
+  explicit Profiler(bool record_trace);
+
+  // Returns true if trace events are recorded.
+  bool records_trace() const { return record_trace_; }
+
+  // Starts the record of the pass |name|, which is about to run on |module|.
+  void BeginPass(const char* name, const Module& module);
+
+  // Ends the record of the current pass, which left |module| behind and
+  // reported whether it |changed| it.
+  void EndPass(bool changed, const Module& module);
+
+  // Records a trace event |name| in |category| from |start| to |end|.
+  void AddEvent(const std::string& name, const char* category,
+                Clock::time_point start, Clock::time_point end);
+
+  // Returns the records of the passes that ended, in the order they ran.
+  const std::vector<PassRecord>& passes() const { return passes_; }
+
+  // Writes the pass records to |out| as a JSON object with a "passes" array.
+  // Unknown CPU times, memory figures and hardware counts are written as null.
+  void WriteJson(std::ostream& out) const;
+
+  // Writes the trace events to |out| in the Chrome trace event format.
+  void WriteTrace(std::ostream& out) const;
+
+  // Returns the size of |module|.
+  static ModuleSize Measure(const Module& module);
+
+ private:
+  // A complete ("X") trace event. Times are in microseconds since the
+  // profiler was created.
+  struct Event {
+    std::string name;
+    const char* category;
+    double start_us;
+    double duration_us;
+  };
+
+  // The measurements taken when the current pass began.
+  struct PassStart {
+    Clock::time_point wall;
+    std::clock_t cpu;
+    long max_rss_kb;
+    long page_faults;
+  };
+
+  bool record_trace_;
+  Clock::time_point origin_;
+  // The hardware counters, if the library is built with them.
+  std::unique_ptr<utils::PerfCounters> perf_counters_;
+  std::vector<PassRecord> passes_;
+  PassStart pass_start_;
+  std::vector<Event> events_;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_PROFILER_H_
@@ -14,7 +14,7 @@
 
 #include "source/opt/remove_duplicates_pass.h"
 
-#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -23,9 +23,37 @@
 #include "source/opcode.h"
 #include "source/opt/decoration_manager.h"
 #include "source/opt/ir_context.h"
+#include "source/opt/type_manager.h"
+#include "source/util/hash_combine.h"
 
 namespace spvtools {
 namespace opt {
+namespace {
+
+// Hashes a forward pointer consistently with ForwardPointer::IsSame(), which
+// compares the pointer types rather than the target ids once the target
+// pointer is known. ForwardPointer::HashValue() mixes in the target id, so it
+// cannot be used for that.
+struct HashForwardPointer {
+  size_t operator()(const analysis::ForwardPointer* type) const {
+    assert(type);
+    const size_t pointee_hash = type->target_pointer()
+                                    ? type->target_pointer()->HashValue()
+                                    : type->target_id();
+    return utils::hash_combine(pointee_hash,
+                               uint32_t(type->storage_class()));
+  }
+};
+
+struct CompareForwardPointers {
+  bool operator()(const analysis::ForwardPointer* lhs,
+                  const analysis::ForwardPointer* rhs) const {
+    assert(lhs && rhs);
+    return lhs->IsSame(rhs);
+  }
+};
+
+}  // namespace
 
 Pass::Status RemoveDuplicatesPass::Process() {
   bool modified = RemoveDuplicateCapabilities();
@@ -141,8 +169,16 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
   analysis::TypeManager type_manager(context()->consumer(), context());
 
-  std::vector<Instruction*> visited_types;
-  std::vector<analysis::ForwardPointer> visited_forward_pointers;
+  // Maps each type seen so far to the id of its first definition. Types are
+  // hashed structurally, so finding an earlier equal type takes expected
+  // constant time instead of a scan over every type visited before.
+  std::unordered_map<const analysis::Type*, spv::Id, analysis::HashTypePointer,
+                     analysis::CompareTypePointers>
+      visited_types;
+  std::vector<std::unique_ptr<analysis::ForwardPointer>> forward_pointers;
+  std::unordered_set<const analysis::ForwardPointer*, HashForwardPointer,
+                     CompareForwardPointers>
+      visited_forward_pointers;
   std::vector<Instruction*> to_delete;
   for (auto* i = &*context()->types_values_begin(); i; i = i->NextNode()) {
     const bool is_i_forward_pointer =
@@ -155,47 +191,28 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
     if (!is_i_forward_pointer) {
       // Is the current type equal to one of the types we have already visited?
-      spv::Id id_to_keep = 0u;
-      analysis::Type* i_type = type_manager.GetType(i->result_id());
+      const analysis::Type* i_type = type_manager.GetType(i->result_id());
       assert(i_type);
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
-      for (auto j : visited_types) {
-        analysis::Type* j_type = type_manager.GetType(j->result_id());
-        assert(j_type);
-        if (*i_type == *j_type) {
-          id_to_keep = j->result_id();
-          break;
-        }
-      }
+      const auto insertion = visited_types.insert({i_type, i->result_id()});
 
-      if (id_to_keep == 0u) {
-        // This is a never seen before type, keep it around.
-        visited_types.emplace_back(i);
-      } else {
+      if (!insertion.second) {
         // The same type has already been seen before, remove this one.
+        const spv::Id id_to_keep = insertion.first->second;
         context()->KillNamesAndDecorates(i->result_id());
         context()->ReplaceAllUsesWith(i->result_id(), id_to_keep);
         modified = true;
         to_delete.emplace_back(i);
       }
     } else {
-      analysis::ForwardPointer i_type(
+      auto i_type = MakeUnique<analysis::ForwardPointer>(
           i->GetSingleWordInOperand(0u),
           (spv::StorageClass)i->GetSingleWordInOperand(1u));
-      i_type.SetTargetPointer(
-          type_manager.GetType(i_type.target_id())->AsPointer());
-
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
-      const bool found_a_match =
-          std::find(std::begin(visited_forward_pointers),
-                    std::end(visited_forward_pointers),
-                    i_type) != std::end(visited_forward_pointers);
+      i_type->SetTargetPointer(
+          type_manager.GetType(i_type->target_id())->AsPointer());
 
-      if (!found_a_match) {
+      if (visited_forward_pointers.insert(i_type.get()).second) {
         // This is a never seen before type, keep it around.
-        visited_forward_pointers.emplace_back(i_type);
+        forward_pointers.push_back(std::move(i_type));
       } else {
         // The same type has already been seen before, remove this one.
         modified = true;
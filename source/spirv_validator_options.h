@@ -21,6 +21,12 @@
 // returns the Enum for option in this case). Returns false otherwise.
 bool spvParseUniversalLimitsOptions(const char* s, spv_validator_limit* limit);
 
+namespace spvtools {
+namespace val {
+class FunctionCheckCache;
+}  // namespace val
+}  // namespace spvtools
+
 // Default initialization of this structure is to the default Universal Limits
 // described in the SPIR-V Spec.
 struct validator_universal_limits_t {
@@ -51,7 +57,9 @@ struct spv_validator_options_t {
         allow_offset_texture_operand(false),
         allow_vulkan_32_bit_bitwise(false),
         before_hlsl_legalization(false),
-        use_friendly_names(true) {}
+        use_friendly_names(true),
+        num_threads(1),
+        function_check_cache(nullptr) {}
 
   validator_universal_limits_t universal_limits_;
   bool relax_struct_store;
@@ -66,6 +74,12 @@ struct spv_validator_options_t {
   bool allow_vulkan_32_bit_bitwise;
   bool before_hlsl_legalization;
   bool use_friendly_names;
+  uint32_t num_threads;
+  // Not exposed through the public API. When set, the control flow and
+  // dominance checks are skipped for functions that are unchanged since the
+  // last module that passed validation with the same cache. Used by the
+  // optimizer to validate after every pass.
+  spvtools::val::FunctionCheckCache* function_check_cache;
 };
 
 #endif  // SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/arena.h"
+
+#include <cstddef>
+#include <new>
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+thread_local Arena* current_arena = nullptr;
+
+#if defined(SPIRV_OPT_USE_ARENA)
+// Stored in front of every ArenaObject. Its size keeps the object aligned for
+// any fundamental type.
+struct alignas(alignof(std::max_align_t)) ObjectHeader {
+  Arena* arena;
+  size_t size;
+};
+#endif
+
+}  // namespace
+
+Arena::Arena()
+    : cursor_(nullptr), end_(nullptr), free_lists_(), bytes_reserved_(0) {}
+
+Arena::~Arena() {
+  for (void* block : blocks_) {
+    ::operator delete(block);
+  }
+}
+
+size_t Arena::SizeClass(size_t size) {
+  return size == 0 ? 0 : (size - 1) / kGranularity;
+}
+
+void* Arena::Allocate(size_t size) {
+  if (size > kMaxSmallSize) {
+    return ::operator new(size);
+  }
+
+  const size_t size_class = SizeClass(size);
+  const size_t rounded = (size_class + 1) * kGranularity;
+  FreeNode*& free_list = free_lists_[size_class];
+  if (free_list != nullptr) {
+    FreeNode* node = free_list;
+    free_list = node->next;
+    return node;
+  }
+
+  if (static_cast<size_t>(end_ - cursor_) < rounded) {
+    void* block = ::operator new(kBlockSize);
+    blocks_.push_back(block);
+    bytes_reserved_ += kBlockSize;
+    cursor_ = static_cast<char*>(block);
+    end_ = cursor_ + kBlockSize;
+  }
+  void* result = cursor_;
+  cursor_ += rounded;
+  return result;
+}
+
+void Arena::Deallocate(void* ptr, size_t size) {
+  if (ptr == nullptr) return;
+  if (size > kMaxSmallSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  FreeNode*& free_list = free_lists_[SizeClass(size)];
+  FreeNode* node = static_cast<FreeNode*>(ptr);
+  node->next = free_list;
+  free_list = node;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous_(current_arena) {
+  current_arena = arena;
+}
+
+ArenaScope::~ArenaScope() { current_arena = previous_; }
+
+Arena* ArenaScope::current() { return current_arena; }
+
+#if defined(SPIRV_OPT_USE_ARENA)
+void* ArenaObject::operator new(size_t size) {
+  Arena* arena = current_arena;
+  const size_t total = sizeof(ObjectHeader) + size;
+  void* memory = arena ? arena->Allocate(total) : ::operator new(total);
+  ObjectHeader* header = new (memory) ObjectHeader{arena, total};
+  return header + 1;
+}
+
+void ArenaObject::operator delete(void* ptr) {
+  if (ptr == nullptr) return;
+  ObjectHeader* header = static_cast<ObjectHeader*>(ptr) - 1;
+  if (header->arena != nullptr) {
+    header->arena->Deallocate(header, header->size);
+  } else {
+    ::operator delete(header);
+  }
+}
+#endif
+
+}  // namespace utils
+}  // namespace spvtools
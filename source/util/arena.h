@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_ARENA_H_
+#define SOURCE_UTIL_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A memory pool for many small objects that live about as long as the pool.
+//
+// Memory is carved out of large blocks, and memory given back with
+// Deallocate() is kept on a free list per size for later requests of the same
+// size. The blocks are only returned to the system when the arena is
+// destroyed, so every object allocated from an arena must be destroyed before
+// the arena is.
+//
+// An arena is not thread-safe.
+class Arena {
+ public:
+  Arena();
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns |size| bytes of memory, aligned for any fundamental type.
+  void* Allocate(size_t size);
+
+  // Gives back memory returned by Allocate(|size|).
+  void Deallocate(void* ptr, size_t size);
+
+  // Returns the number of bytes held in blocks.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  // Sizes are rounded up to a multiple of this value.
+  static constexpr size_t kGranularity = 16;
+  // Larger requests bypass the arena.
+  static constexpr size_t kMaxSmallSize = 1024;
+  static constexpr size_t kNumSizeClasses = kMaxSmallSize / kGranularity;
+  // The size of the blocks the small requests are carved out of.
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  // Returns the index of the free list for requests of |size| bytes, which
+  // must not exceed kMaxSmallSize.
+  static size_t SizeClass(size_t size);
+
+  std::vector<void*> blocks_;
+  char* cursor_;
+  char* end_;
+  FreeNode* free_lists_[kNumSizeClasses];
+  size_t bytes_reserved_;
+};
+
+// Makes |arena| the arena that ArenaObject instances created on the calling
+// thread are allocated from, for as long as the scope lives. A null |arena|
+// makes them use the heap. Scopes can be nested.
+class ArenaScope {
+ public:
+  explicit ArenaScope(Arena* arena);
+  ~ArenaScope();
+
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  // Returns the arena of the innermost scope on the calling thread, or null.
+  static Arena* current();
+
+ private:
+  Arena* previous_;
+};
+
+// A base class for objects that are allocated from the current arena (see
+// ArenaScope) when the library is built with SPIRV_OPT_USE_ARENA. Objects
+// created outside of any scope come from the heap. Each object remembers
+// where it came from, so it can be deleted anywhere, as long as its arena is
+// still alive. Without SPIRV_OPT_USE_ARENA, the default allocation functions
+// are used.
+class ArenaObject {
+#if defined(SPIRV_OPT_USE_ARENA)
+ public:
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+#endif
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_ARENA_H_
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/perf_counters.h"
+
+#include <cassert>
+
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+
+// Opens a counter of the hardware event |config| for the calling thread, in
+// user space only. Returns its file descriptor, or -1 if it cannot be opened.
+int OpenCounter(uint64_t config) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  const long fd = syscall(__NR_perf_event_open, &attr, /* pid = */ 0,
+                          /* cpu = */ -1, /* group_fd = */ -1,
+                          PERF_FLAG_FD_CLOEXEC);
+  return fd < 0 ? -1 : static_cast<int>(fd);
+}
+
+#endif  // defined(SPIRV_PERF_COUNTERS_ENABLED)
+
+}  // namespace
+
+const char* PerfCounterName(PerfCounter counter) {
+  switch (counter) {
+    case kPerfCycles:
+      return "cycles";
+    case kPerfInstructions:
+      return "instructions";
+    case kPerfCacheMisses:
+      return "cache-misses";
+    case kPerfBranchMisses:
+      return "branch-misses";
+    case kNumPerfCounters:
+      break;
+  }
+  assert(false && "Unknown performance counter.");
+  return "";
+}
+
+bool PerfCountersBuiltIn() {
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+  return true;
+#else
+  return false;
+#endif
+}
+
+PerfCounters::PerfCounters() {
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+  fds_[kPerfCycles] = OpenCounter(PERF_COUNT_HW_CPU_CYCLES);
+  fds_[kPerfInstructions] = OpenCounter(PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[kPerfCacheMisses] = OpenCounter(PERF_COUNT_HW_CACHE_MISSES);
+  fds_[kPerfBranchMisses] = OpenCounter(PERF_COUNT_HW_BRANCH_MISSES);
+#else
+  for (int& fd : fds_) fd = -1;
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+  for (int fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+#endif
+}
+
+void PerfCounters::Start() { ReadAll(start_); }
+
+void PerfCounters::Stop() { ReadAll(stop_); }
+
+void PerfCounters::ReadAll(Reading* readings) const {
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    readings[i].valid = false;
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+    if (fds_[i] < 0) continue;
+    uint64_t data[3];
+    if (read(fds_[i], data, sizeof(data)) == sizeof(data)) {
+      readings[i].value = data[0];
+      readings[i].time_enabled = data[1];
+      readings[i].time_running = data[2];
+      readings[i].valid = true;
+    }
+#endif
+  }
+}
+
+long long PerfCounters::Count(PerfCounter counter) const {
+  const Reading& start = start_[counter];
+  const Reading& stop = stop_[counter];
+  if (!start.valid || !stop.valid) return -1;
+  const uint64_t running = stop.time_running - start.time_running;
+  const uint64_t enabled = stop.time_enabled - start.time_enabled;
+  const uint64_t value = stop.value - start.value;
+  if (running == enabled) return static_cast<long long>(value);
+  // The counter was multiplexed with others, so estimate the count over the
+  // whole time it was enabled. If it never ran, the count is unknown.
+  if (running == 0) return -1;
+  return static_cast<long long>(static_cast<double>(value) *
+                                static_cast<double>(enabled) /
+                                static_cast<double>(running));
+}
+
+}  // namespace utils
+}  // namespace spvtools
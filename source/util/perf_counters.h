@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Contains utils for reading hardware performance counters
+
+#ifndef SOURCE_UTIL_PERF_COUNTERS_H_
+#define SOURCE_UTIL_PERF_COUNTERS_H_
+
+#include <cstdint>
+
+namespace spvtools {
+namespace utils {
+
+// The hardware events that PerfCounters counts.
+enum PerfCounter {
+  kPerfCycles = 0,
+  kPerfInstructions,
+  kPerfCacheMisses,
+  kPerfBranchMisses,
+  kNumPerfCounters,
+};
+
+// Returns a short name for |counter|, such as "cycles".
+const char* PerfCounterName(PerfCounter counter);
+
+// Returns true if the library was built with hardware performance counter
+// support (SPIRV_PERF_COUNTERS_ENABLED). Even then, each counter may still be
+// unavailable at run time.
+bool PerfCountersBuiltIn();
+
+// PerfCounters counts the hardware events of the calling thread between
+// Start() and Stop(), using perf_event_open() on Linux. It is only functional
+// if the library is built with SPIRV_PERF_COUNTERS_ENABLED (the CMake option
+// SPIRV_ALLOW_PERF_COUNTERS).
+//
+// A counter that cannot be opened, because of the build, the platform, the
+// kernel.perf_event_paranoid setting, or a virtual machine without a PMU, is
+// reported as -1 and the other counters still work. Counts are scaled when the
+// kernel had to multiplex the counters.
+//
+// Counters are opened by the constructor and closed by the destructor, so a
+// PerfCounters object should be created only when it is going to be used.
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Records the current value of each counter as the start of the
+  // measurement.
+  void Start();
+
+  // Records the current value of each counter as the end of the measurement.
+  void Stop();
+
+  // Returns the number of |counter| events between Start() and Stop(), or -1
+  // if the counter is unavailable.
+  long long Count(PerfCounter counter) const;
+
+  // Returns true if |counter| could be opened.
+  bool IsAvailable(PerfCounter counter) const { return fds_[counter] >= 0; }
+
+ private:
+  // A value read from a counter, with the time it was enabled and the time it
+  // was actually counting.
+  struct Reading {
+    uint64_t value = 0;
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+    bool valid = false;
+  };
+
+  // Reads every available counter into |readings|.
+  void ReadAll(Reading* readings) const;
+
+  // The file descriptor of each counter, or -1.
+  int fds_[kNumPerfCounters];
+  Reading start_[kNumPerfCounters];
+  Reading stop_[kNumPerfCounters];
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_PERF_COUNTERS_H_
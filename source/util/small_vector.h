@@ -19,7 +19,9 @@
 #include <cassert>
 #include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -47,10 +49,7 @@ class SmallVector {
   using iterator = T*;
   using const_iterator = const T*;
 
-  SmallVector()
-      : size_(0),
-        small_data_(reinterpret_cast<T*>(buffer)),
-        large_data_(nullptr) {}
+  SmallVector() : size_(0), large_data_(nullptr) {}
 
   SmallVector(const SmallVector& that) : SmallVector() { *this = that; }
 
@@ -62,14 +61,29 @@ class SmallVector {
     } else {
       size_ = vec.size();
       for (uint32_t i = 0; i < size_; i++) {
-        new (small_data_ + i) T(vec[i]);
+        new (small_data() + i) T(vec[i]);
       }
     }
   }
 
   template <class InputIt>
   SmallVector(InputIt first, InputIt last) : SmallVector() {
-    insert(end(), first, last);
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+      if (static_cast<size_t>(std::distance(first, last)) > small_size) {
+        large_data_ = MakeUnique<std::vector<T>>(first, last);
+      } else {
+        for (; first != last; ++first) {
+          new (small_data() + (size_++)) T(*first);
+        }
+      }
+    } else {
+      // A single-pass range can only be read once, so its length cannot be
+      // measured before copying it.
+      for (; first != last; ++first) {
+        push_back(*first);
+      }
+    }
   }
 
   SmallVector(std::vector<T>&& vec) : SmallVector() {
@@ -78,7 +92,7 @@ class SmallVector {
     } else {
       size_ = vec.size();
       for (uint32_t i = 0; i < size_; i++) {
-        new (small_data_ + i) T(std::move(vec[i]));
+        new (small_data() + i) T(std::move(vec[i]));
       }
     }
     vec.clear();
@@ -87,7 +101,7 @@ class SmallVector {
   SmallVector(std::initializer_list<T> init_list) : SmallVector() {
     if (init_list.size() < small_size) {
       for (auto it = init_list.begin(); it != init_list.end(); ++it) {
-        new (small_data_ + (size_++)) T(std::move(*it));
+        new (small_data() + (size_++)) T(std::move(*it));
       }
     } else {
       large_data_ = MakeUnique<std::vector<T>>(std::move(init_list));
@@ -96,14 +110,13 @@ class SmallVector {
 
   SmallVector(size_t s, const T& v) : SmallVector() { resize(s, v); }
 
-  virtual ~SmallVector() {
-    for (T* p = small_data_; p < small_data_ + size_; ++p) {
+  ~SmallVector() {
+    for (T* p = small_data(); p < small_data() + size_; ++p) {
       p->~T();
     }
   }
 
   SmallVector& operator=(const SmallVector& that) {
-    assert(small_data_);
     if (that.large_data_) {
       if (large_data_) {
         *large_data_ = *that.large_data_;
@@ -115,20 +128,20 @@ class SmallVector {
       size_t i = 0;
       // Do a copy for any element in |this| that is already constructed.
       for (; i < size_ && i < that.size_; ++i) {
-        small_data_[i] = that.small_data_[i];
+        small_data()[i] = that.small_data()[i];
       }
 
       if (i >= that.size_) {
         // If the size of |this| becomes smaller after the assignment, then
         // destroy any extra elements.
         for (; i < size_; ++i) {
-          small_data_[i].~T();
+          small_data()[i].~T();
         }
       } else {
         // If the size of |this| becomes larger after the assignement, copy
         // construct the new elements that are needed.
         for (; i < that.size_; ++i) {
-          new (small_data_ + i) T(that.small_data_[i]);
+          new (small_data() + i) T(that.small_data()[i]);
         }
       }
       size_ = that.size_;
@@ -144,20 +157,20 @@ class SmallVector {
       size_t i = 0;
       // Do a move for any element in |this| that is already constructed.
       for (; i < size_ && i < that.size_; ++i) {
-        small_data_[i] = std::move(that.small_data_[i]);
+        small_data()[i] = std::move(that.small_data()[i]);
       }
 
       if (i >= that.size_) {
         // If the size of |this| becomes smaller after the assignment, then
         // destroy any extra elements.
         for (; i < size_; ++i) {
-          small_data_[i].~T();
+          small_data()[i].~T();
         }
       } else {
         // If the size of |this| becomes larger after the assignement, move
         // construct the new elements that are needed.
         for (; i < that.size_; ++i) {
-          new (small_data_ + i) T(std::move(that.small_data_[i]));
+          new (small_data() + i) T(std::move(that.small_data()[i]));
         }
       }
       size_ = that.size_;
@@ -201,7 +214,7 @@ class SmallVector {
 
   T& operator[](size_t i) {
     if (!large_data_) {
-      return small_data_[i];
+      return small_data()[i];
     } else {
       return (*large_data_)[i];
     }
@@ -209,7 +222,7 @@ class SmallVector {
 
   const T& operator[](size_t i) const {
     if (!large_data_) {
-      return small_data_[i];
+      return small_data()[i];
     } else {
       return (*large_data_)[i];
     }
@@ -227,7 +240,7 @@ class SmallVector {
     if (large_data_) {
       return large_data_->data();
     } else {
-      return small_data_;
+      return small_data();
     }
   }
 
@@ -235,7 +248,7 @@ class SmallVector {
     if (large_data_) {
       return large_data_->data();
     } else {
-      return small_data_;
+      return small_data();
     }
   }
 
@@ -245,7 +258,7 @@ class SmallVector {
     if (large_data_) {
       return large_data_->data() + large_data_->size();
     } else {
-      return small_data_ + size_;
+      return small_data() + size_;
     }
   }
 
@@ -253,7 +266,7 @@ class SmallVector {
     if (large_data_) {
       return large_data_->data() + large_data_->size();
     } else {
-      return small_data_ + size_;
+      return small_data() + size_;
     }
   }
 
@@ -319,7 +332,7 @@ class SmallVector {
       return;
     }
 
-    new (small_data_ + size_) T(value);
+    new (small_data() + size_) T(value);
     ++size_;
   }
 
@@ -333,7 +346,7 @@ class SmallVector {
       return;
     }
 
-    new (small_data_ + size_) T(std::move(value));
+    new (small_data() + size_) T(std::move(value));
     ++size_;
   }
 
@@ -342,7 +355,7 @@ class SmallVector {
       large_data_->pop_back();
     } else {
       --size_;
-      small_data_[size_].~T();
+      small_data()[size_].~T();
     }
   }
 
@@ -377,7 +390,7 @@ class SmallVector {
     // Copy the new elements into position.
     iterator p = pos;
     for (; first != last; ++p, ++first) {
-      if (p >= small_data_ + size_) {
+      if (p >= small_data() + size_) {
         new (p) T(*first);
       } else {
         *p = *first;
@@ -413,7 +426,7 @@ class SmallVector {
     if (large_data_) {
       large_data_->emplace_back(std::forward<Args>(args)...);
     } else {
-      new (small_data_ + size_) T(std::forward<Args>(args)...);
+      new (small_data() + size_) T(std::forward<Args>(args)...);
       ++size_;
     }
   }
@@ -430,12 +443,12 @@ class SmallVector {
 
     // If |new_size| < |size_|, then destroy the extra elements.
     for (size_t i = new_size; i < size_; ++i) {
-      small_data_[i].~T();
+      small_data()[i].~T();
     }
 
     // If |new_size| > |size_|, the copy construct the new elements.
     for (size_t i = size_; i < new_size; ++i) {
-      new (small_data_ + i) T(v);
+      new (small_data() + i) T(v);
     }
 
     // Update the size.
@@ -443,26 +456,32 @@ class SmallVector {
   }
 
  private:
-  // Moves all of the element from |small_data_| into a new std::vector that can
-  // be access through |large_data|.
+  // Moves all of the element from |small_data()| into a new std::vector that
+  // can be access through |large_data|.
   void MoveToLargeData() {
     assert(!large_data_);
     large_data_ = MakeUnique<std::vector<T>>();
     for (size_t i = 0; i < size_; ++i) {
-      large_data_->emplace_back(std::move(small_data_[i]));
+      large_data_->emplace_back(std::move(small_data()[i]));
     }
     DestructSmallData();
   }
 
-  // Destroys all of the elements in |small_data_| that have been constructed.
+  // Returns the array used to hold the elements when the number of elements is
+  // small.  It is computed from |buffer| rather than stored, which keeps small
+  // vectors, and every |Operand| in the optimizer's IR, compact.
+  T* small_data() { return reinterpret_cast<T*>(buffer); }
+  const T* small_data() const { return reinterpret_cast<const T*>(buffer); }
+
+  // Destroys all of the elements in |small_data()| that have been constructed.
   void DestructSmallData() {
     for (size_t i = 0; i < size_; ++i) {
-      small_data_[i].~T();
+      small_data()[i].~T();
     }
     size_ = 0;
   }
 
-  // The number of elements in |small_data_| that have been constructed.
+  // The number of elements in |small_data()| that have been constructed.
   size_t size_;
 
   // A type with the same alignment and size as T, but will is POD.
@@ -471,16 +490,12 @@ class SmallVector {
   };
 
   // The actual data used to store the array elements.  It must never be used
-  // directly, but must only be accessed through |small_data_|.
+  // directly, but must only be accessed through |small_data()|.
   PodType buffer[small_size];
 
-  // The pointed used to access the array of elements when the number of
-  // elements is small.
-  T* small_data_;
-
   // A pointer to a vector that is used to store the elements of the vector when
   // this size exceeds |small_size|.  If |large_data_| is nullptr, then the data
-  // is stored in |small_data_|.  Otherwise, the data is stored in
+  // is stored in |small_data()|.  Otherwise, the data is stored in
   // |large_data_|.
   std::unique_ptr<std::vector<T>> large_data_;
 };  // namespace utils
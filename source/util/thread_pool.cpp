@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/thread_pool.h"
+
+namespace spvtools {
+namespace utils {
+
+ThreadPool::ThreadPool(uint32_t num_threads) {
+  for (uint32_t i = 1; i < num_threads; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& task) {
+  if (workers_.empty() || count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> job_lock(job_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_index_.store(0);
+    busy_workers_ = workers_.size();
+    ++generation_;
+  }
+  work_available_.notify_all();
+
+  RunTasks();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this]() { return busy_workers_ == 0; });
+  task_ = nullptr;
+  count_ = 0;
+}
+
+uint32_t ThreadPool::HardwareConcurrency() {
+  const unsigned int concurrency = std::thread::hardware_concurrency();
+  return concurrency == 0 ? 1 : static_cast<uint32_t>(concurrency);
+}
+
+void ThreadPool::WorkerLoop() {
+  uint64_t last_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [this, last_generation]() {
+        return stopping_ || generation_ != last_generation;
+      });
+      if (stopping_) return;
+      last_generation = generation_;
+    }
+
+    RunTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --busy_workers_;
+    }
+    work_done_.notify_one();
+  }
+}
+
+void ThreadPool::RunTasks() {
+  for (size_t i = next_index_.fetch_add(1); i < count_;
+       i = next_index_.fetch_add(1)) {
+    (*task_)(i);
+  }
+}
+
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_THREAD_POOL_H_
+#define SOURCE_UTIL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A fixed set of worker threads that run independent, indexed tasks.
+//
+// ParallelFor(n, task) calls task(0), ..., task(n - 1), each exactly once, on
+// the workers and on the calling thread, and returns once every call has
+// finished. Threads take the next unclaimed index from a shared counter as
+// soon as they are done with their current task, so a few expensive tasks do
+// not hold up the cheap ones.
+//
+// The order in which tasks run is unspecified. Callers that need
+// deterministic results must have each task write to its own slot, and
+// combine the slots in index order once ParallelFor returns.
+class ThreadPool {
+ public:
+  // Creates a pool that runs tasks on |num_threads| threads, counting the
+  // thread that calls ParallelFor. A pool with 0 or 1 threads runs every task
+  // on the calling thread.
+  explicit ThreadPool(uint32_t num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Returns the number of threads that run tasks, counting the caller.
+  uint32_t num_threads() const {
+    return static_cast<uint32_t>(workers_.size()) + 1;
+  }
+
+  // Calls |task| with every index in [0, |count|) and waits for all of the
+  // calls to finish. Calls from different threads are serialized. |task| must
+  // not call ParallelFor on the same pool.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+  // Returns the number of threads the hardware can run concurrently, or 1 if
+  // it is not known.
+  static uint32_t HardwareConcurrency();
+
+ private:
+  // The body of every worker thread: waits for jobs and runs their tasks.
+  void WorkerLoop();
+
+  // Runs tasks of the current job until every index has been claimed.
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+
+  // Serializes calls to ParallelFor.
+  std::mutex job_mutex_;
+
+  // Guards the fields below, except |next_index_|.
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+
+  // The current job.
+  const std::function<void(size_t)>* task_ = nullptr;
+  size_t count_ = 0;
+  std::atomic<size_t> next_index_{0};
+
+  // Incremented for every job, so that workers can tell a new job apart from
+  // the one they last worked on.
+  uint64_t generation_ = 0;
+
+  // Number of workers that have not yet finished the current job.
+  size_t busy_workers_ = 0;
+
+  // Set when the pool is destroyed.
+  bool stopping_ = false;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_THREAD_POOL_H_
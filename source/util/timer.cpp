@@ -33,6 +33,10 @@ void PrintTimerDescription(std::ostream* out, bool measure_mem_usage) {
     if (measure_mem_usage) {
       *out << std::setw(12) << "RSS delta" << std::setw(16) << "PGFault delta";
     }
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+    *out << std::setw(16) << "Cycles" << std::setw(16) << "Instructions"
+         << std::setw(14) << "Cache misses" << std::setw(14) << "Branch misses";
+#endif
     *out << std::endl;
   }
 }
@@ -40,20 +44,27 @@ void PrintTimerDescription(std::ostream* out, bool measure_mem_usage) {
 // Do not change the order of invoking system calls. We want to make CPU/Wall
 // time correct as much as possible. Calling functions to get CPU/Wall time must
 // closely surround the target code of measuring.
+// The hardware counters are read last in Start() and first in Stop(), because
+// they are the most sensitive to the work done by the other calls.
 void Timer::Start() {
   if (report_stream_) {
+    if (PerfCountersBuiltIn() && !perf_counters_) {
+      perf_counters_.reset(new PerfCounters());
+    }
     if (getrusage(RUSAGE_SELF, &usage_before_) == -1)
       usage_status_ |= kGetrusageFailed;
     if (clock_gettime(CLOCK_MONOTONIC, &wall_before_) == -1)
       usage_status_ |= kClockGettimeWalltimeFailed;
     if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_before_) == -1)
       usage_status_ |= kClockGettimeCPUtimeFailed;
+    if (perf_counters_) perf_counters_->Start();
   }
 }
 
 // The order of invoking system calls is important with the same reason as
 // Timer::Start().
 void Timer::Stop() {
+  if (report_stream_ && perf_counters_) perf_counters_->Stop();
   if (report_stream_ && usage_status_ == kSucceeded) {
     if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_after_) == -1)
       usage_status_ |= kClockGettimeCPUtimeFailed;
@@ -93,6 +104,17 @@ void Timer::Report(const char* tag) {
                       << PageFault();
     }
   }
+
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+  const int widths[kNumPerfCounters] = {16, 16, 14, 14};
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    const long long count = PerfCount(PerfCounter(i));
+    if (count < 0)
+      *report_stream_ << std::setw(widths[i]) << "n/a";
+    else
+      *report_stream_ << std::setw(widths[i]) << count;
+  }
+#endif
   *report_stream_ << std::endl;
 }
 
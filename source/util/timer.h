@@ -22,6 +22,9 @@
 #include <sys/resource.h>
 #include <cassert>
 #include <iostream>
+#include <memory>
+
+#include "source/util/perf_counters.h"
 
 // A macro to call spvtools::utils::PrintTimerDescription(std::ostream*, bool).
 // The first argument must be given as std::ostream*. If it is NULL, the
@@ -78,8 +81,10 @@ enum UsageStatus {
 // utilization consists of CPU time (i.e., process time), WALL time (elapsed
 // time), USR time, SYS time, RSS delta, and the delta of the number of page
 // faults. RSS delta and the delta of the number of page faults are measured
-// only when |measure_mem_usage| given to the constructor is true. This class
-// should be used as the following example:
+// only when |measure_mem_usage| given to the constructor is true. When the
+// library is built with SPIRV_PERF_COUNTERS_ENABLED, it also counts the cycles,
+// instructions, cache misses and branch misses of the calling thread (see
+// PerfCounters). This class should be used as the following example:
 //
 //   spvtools::utils::Timer timer(std::cout);
 //   timer.Start();       // <-- set |usage_before_|, |wall_before_|,
@@ -166,6 +171,14 @@ class Timer {
            (usage_after_.ru_majflt - usage_before_.ru_majflt);
   }
 
+  // Returns the number of |counter| hardware events for a range of code
+  // execution. If the library is built without SPIRV_PERF_COUNTERS_ENABLED or
+  // the counter is not available, it returns -1.
+  virtual long long PerfCount(PerfCounter counter) const {
+    if (!perf_counters_) return -1;
+    return perf_counters_->Count(counter);
+  }
+
   virtual ~Timer() {}
 
  private:
@@ -222,6 +235,11 @@ class Timer {
   // If true, Timer reports the memory usage information too. Otherwise, Timer
   // reports only USR time, WALL time, SYS time.
   bool measure_mem_usage_;
+
+  // The hardware counters, opened by the first call to Start() when the
+  // library is built with SPIRV_PERF_COUNTERS_ENABLED and there is a report
+  // stream. Null otherwise.
+  std::unique_ptr<PerfCounters> perf_counters_;
 };
 
 // The purpose of ScopedTimer is to measure the resource utilization for a
@@ -300,7 +318,8 @@ class CumulativeTimer : public Timer {
         usr_time_(0),
         sys_time_(0),
         rss_(0),
-        pgfaults_(0) {}
+        pgfaults_(0),
+        perf_counts_() {}
 
   // If we cannot get a resource usage because of failures, it sets -1 for the
   // resource usage.
@@ -336,6 +355,14 @@ class CumulativeTimer : public Timer {
       pgfaults_ += Timer::PageFault();
     else
       pgfaults_ = -1;
+
+    for (int i = 0; i < kNumPerfCounters; ++i) {
+      const long long count = Timer::PerfCount(PerfCounter(i));
+      if (perf_counts_[i] >= 0 && count >= 0)
+        perf_counts_[i] += count;
+      else
+        perf_counts_[i] = -1;
+    }
   }
 
   // Returns the cumulative CPU Time (i.e., process time) for a range of code
@@ -359,6 +386,12 @@ class CumulativeTimer : public Timer {
   // execution.
   long PageFault() const override { return pgfaults_; }
 
+  // Returns the cumulative number of |counter| hardware events for a range of
+  // code execution.
+  long long PerfCount(PerfCounter counter) const override {
+    return perf_counts_[counter];
+  }
+
  private:
   // Variable to save the cumulative CPU time (i.e., process time).
   double cpu_time_;
@@ -377,6 +410,9 @@ class CumulativeTimer : public Timer {
 
   // Variable to save the cumulative delta of the number of page faults.
   long pgfaults_;
+
+  // Variable to save the cumulative number of each hardware event.
+  long long perf_counts_[kNumPerfCounters];
 };
 
 }  // namespace utils
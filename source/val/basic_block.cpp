@@ -25,6 +25,9 @@ BasicBlock::BasicBlock(uint32_t label_id)
       immediate_dominator_(nullptr),
       immediate_structural_dominator_(nullptr),
       immediate_structural_post_dominator_(nullptr),
+      dominator_interval_(),
+      structural_dominator_interval_(),
+      structural_post_dominator_interval_(),
       predecessors_(),
       successors_(),
       type_(0),
@@ -78,21 +81,36 @@ void BasicBlock::RegisterSuccessors(
 }
 
 bool BasicBlock::dominates(const BasicBlock& other) const {
-  return (this == &other) ||
-         !(other.dom_end() ==
+  if (this == &other) return true;
+  if (dominator_interval_.valid() && other.dominator_interval_.valid()) {
+    return dominator_interval_.contains(other.dominator_interval_);
+  }
+  return !(other.dom_end() ==
            std::find(other.dom_begin(), other.dom_end(), this));
 }
 
 bool BasicBlock::structurally_dominates(const BasicBlock& other) const {
-  return (this == &other) || !(other.structural_dom_end() ==
-                               std::find(other.structural_dom_begin(),
-                                         other.structural_dom_end(), this));
+  if (this == &other) return true;
+  if (structural_dominator_interval_.valid() &&
+      other.structural_dominator_interval_.valid()) {
+    return structural_dominator_interval_.contains(
+        other.structural_dominator_interval_);
+  }
+  return !(other.structural_dom_end() ==
+           std::find(other.structural_dom_begin(), other.structural_dom_end(),
+                     this));
 }
 
 bool BasicBlock::structurally_postdominates(const BasicBlock& other) const {
-  return (this == &other) || !(other.structural_pdom_end() ==
-                               std::find(other.structural_pdom_begin(),
-                                         other.structural_pdom_end(), this));
+  if (this == &other) return true;
+  if (structural_post_dominator_interval_.valid() &&
+      other.structural_post_dominator_interval_.valid()) {
+    return structural_post_dominator_interval_.contains(
+        other.structural_post_dominator_interval_);
+  }
+  return !(other.structural_pdom_end() ==
+           std::find(other.structural_pdom_begin(),
+                     other.structural_pdom_end(), this));
 }
 
 BasicBlock::DominatorIterator::DominatorIterator() : current_(nullptr) {}
@@ -42,6 +42,25 @@ class Instruction;
 // This class represents a basic block in a SPIR-V module
 class BasicBlock {
  public:
+  /// The position of a block in a dominator tree, given by the root of the
+  /// tree and the pre- and post-order numbers of the block in a depth-first
+  /// walk of it. A block dominates another exactly when its interval contains
+  /// the other's. The root is null while the interval has not been computed.
+  struct DominatorInterval {
+    const BasicBlock* root = nullptr;
+    uint32_t pre = 0;
+    uint32_t post = 0;
+
+    /// Returns true if the interval has been computed.
+    bool valid() const { return root != nullptr; }
+
+    /// Returns true if |other| is in the same tree and nested in this
+    /// interval.
+    bool contains(const DominatorInterval& other) const {
+      return root == other.root && pre <= other.pre && other.post <= post;
+    }
+  };
+
   /// Constructor for a BasicBlock
   ///
   /// @param[in] id The ID of the basic block
@@ -145,6 +164,25 @@ class BasicBlock {
   /// Returns the immediate post dominator of this basic block
   const BasicBlock* immediate_structural_post_dominator() const;
 
+  /// Sets the position of this block in the dominator tree. The intervals of
+  /// all blocks of a function are set together by
+  /// Function::ComputeDominatorIntervals, and must be recomputed whenever an
+  /// immediate dominator changes.
+  void set_dominator_interval(const DominatorInterval& interval) {
+    dominator_interval_ = interval;
+  }
+
+  /// Sets the position of this block in the structural dominator tree.
+  void set_structural_dominator_interval(const DominatorInterval& interval) {
+    structural_dominator_interval_ = interval;
+  }
+
+  /// Sets the position of this block in the structural post dominator tree.
+  void set_structural_post_dominator_interval(
+      const DominatorInterval& interval) {
+    structural_post_dominator_interval_ = interval;
+  }
+
   /// Returns the label instruction for the block, or nullptr if not set.
   const Instruction* label() const { return label_; }
 
@@ -168,7 +206,10 @@ class BasicBlock {
   bool operator==(const uint32_t& other_id) const { return other_id == id_; }
 
   /// Returns true if this block dominates the other block.
-  /// Assumes dominators have been computed.
+  /// Assumes dominators have been computed. Takes constant time if the
+  /// dominator intervals of both blocks have been computed, and walks the
+  /// dominators of |other| otherwise. The same holds for the structural
+  /// queries below.
   bool dominates(const BasicBlock& other) const;
 
   /// Returns true if this block structurally dominates the other block.
@@ -279,6 +320,11 @@ class BasicBlock {
   /// Pointer to the immediate structural post dominator of the BasicBlock
   BasicBlock* immediate_structural_post_dominator_;
 
+  /// Positions of the BasicBlock in its dominator trees
+  DominatorInterval dominator_interval_;
+  DominatorInterval structural_dominator_interval_;
+  DominatorInterval structural_post_dominator_interval_;
+
   /// The set of predecessors of the BasicBlock
   std::vector<BasicBlock*> predecessors_;
 
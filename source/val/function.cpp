@@ -16,9 +16,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "source/cfa.h"
 #include "source/val/basic_block.h"
@@ -31,6 +33,59 @@ namespace val {
 // Universal Limit of ResultID + 1
 static const uint32_t kInvalidId = 0x400000;
 
+namespace {
+
+// Numbers the trees of the forest over |blocks| in which the parent of a block
+// is |parent(block)|, and passes the interval of every block to |set|. A block
+// without a parent, or which is its own parent, is a root.
+void NumberDominatorForest(
+    const std::vector<BasicBlock*>& blocks,
+    const std::function<BasicBlock*(BasicBlock*)>& parent,
+    const std::function<void(BasicBlock*,
+                             const BasicBlock::DominatorInterval&)>& set) {
+  std::unordered_map<const BasicBlock*, std::vector<BasicBlock*>> children;
+  std::vector<BasicBlock*> roots;
+  for (auto* block : blocks) {
+    BasicBlock* p = parent(block);
+    if (p == nullptr || p == block) {
+      roots.push_back(block);
+    } else {
+      children[p].push_back(block);
+    }
+  }
+
+  // The walk is iterative, since dominator trees of unrolled code can be
+  // deeper than the stack allows.
+  struct Frame {
+    BasicBlock* block;
+    uint32_t pre;
+    const std::vector<BasicBlock*>* children;
+    size_t next_child;
+  };
+  const std::vector<BasicBlock*> no_children;
+  auto children_of = [&children, &no_children](const BasicBlock* block) {
+    auto where = children.find(block);
+    return where == children.end() ? &no_children : &where->second;
+  };
+  std::vector<Frame> stack;
+  for (auto* root : roots) {
+    uint32_t counter = 0;
+    stack.push_back({root, ++counter, children_of(root), 0});
+    while (!stack.empty()) {
+      Frame& top = stack.back();
+      if (top.next_child < top.children->size()) {
+        BasicBlock* child = (*top.children)[top.next_child++];
+        stack.push_back({child, ++counter, children_of(child), 0});
+      } else {
+        set(top.block, {root, top.pre, ++counter});
+        stack.pop_back();
+      }
+    }
+  }
+}
+
+}  // namespace
+
 Function::Function(uint32_t function_id, uint32_t result_type_id,
                    spv::FunctionControlMask function_control,
                    uint32_t function_type_id)
@@ -281,6 +336,32 @@ Function::AugmentedStructuralCFGPredecessorsFunction() const {
   };
 }
 
+void Function::ComputeDominatorIntervals() {
+  std::vector<BasicBlock*> blocks;
+  blocks.reserve(blocks_.size() + 2);
+  blocks.push_back(&pseudo_entry_block_);
+  for (auto& id_and_block : blocks_) blocks.push_back(&id_and_block.second);
+  blocks.push_back(&pseudo_exit_block_);
+
+  NumberDominatorForest(
+      blocks, [](BasicBlock* b) { return b->immediate_dominator(); },
+      [](BasicBlock* b, const BasicBlock::DominatorInterval& interval) {
+        b->set_dominator_interval(interval);
+      });
+  NumberDominatorForest(
+      blocks,
+      [](BasicBlock* b) { return b->immediate_structural_dominator(); },
+      [](BasicBlock* b, const BasicBlock::DominatorInterval& interval) {
+        b->set_structural_dominator_interval(interval);
+      });
+  NumberDominatorForest(
+      blocks,
+      [](BasicBlock* b) { return b->immediate_structural_post_dominator(); },
+      [](BasicBlock* b, const BasicBlock::DominatorInterval& interval) {
+        b->set_structural_post_dominator_interval(interval);
+      });
+}
+
 void Function::ComputeAugmentedCFG() {
   // Compute the successors of the pseudo-entry block, and
   // the predecessors of the pseudo exit block.
@@ -194,6 +194,12 @@ class Function {
   /// Returns the block structural predecessors function for the augmented CFG.
   GetBlocksFunction AugmentedStructuralCFGPredecessorsFunction() const;
 
+  /// Numbers the blocks of each dominator tree of the function, including the
+  /// pseudo entry and exit blocks, so that dominance queries between them take
+  /// constant time. Must be called again after any immediate dominator of a
+  /// block of the function changes.
+  void ComputeDominatorIntervals();
+
   /// Returns the control flow nesting depth of the given basic block.
   /// This function only works when you have structured control flow.
   /// This function should only be called after the control flow constructs have
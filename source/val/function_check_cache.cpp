@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/val/function_check_cache.h"
+
+#include <utility>
+
+#include "source/util/hash_combine.h"
+#include "source/val/instruction.h"
+#include "source/val/validation_state.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+// The words of one function of a module.
+struct FunctionWords {
+  uint32_t id;
+  std::vector<uint32_t> words;
+};
+
+// Appends the version of the module in |_| and the words of its instructions
+// outside of functions to |module_words|, and the words of each of its
+// functions to |functions|.
+void SplitModule(const ValidationState_t& _,
+                 std::vector<uint32_t>* module_words,
+                 std::vector<FunctionWords>* functions) {
+  module_words->push_back(_.version());
+  std::vector<uint32_t>* current = module_words;
+  for (const Instruction& inst : _.ordered_instructions()) {
+    if (inst.opcode() == spv::Op::OpFunction) {
+      functions->push_back({inst.id(), {}});
+      current = &functions->back().words;
+    }
+    current->insert(current->end(), inst.words().begin(), inst.words().end());
+    if (inst.opcode() == spv::Op::OpFunctionEnd) current = module_words;
+  }
+}
+
+}  // namespace
+
+size_t FunctionCheckCache::WordsHash::operator()(
+    const std::vector<uint32_t>& words) const {
+  return utils::hash_combine(0, words);
+}
+
+std::unordered_set<uint32_t> FunctionCheckCache::FindUnchangedFunctions(
+    const ValidationState_t& _) const {
+  std::unordered_set<uint32_t> unchanged;
+  if (functions_.empty()) return unchanged;
+
+  std::vector<uint32_t> module_words;
+  std::vector<FunctionWords> functions;
+  SplitModule(_, &module_words, &functions);
+  if (module_words != module_words_) return unchanged;
+
+  for (const FunctionWords& function : functions) {
+    if (functions_.count(function.words)) unchanged.insert(function.id);
+  }
+  return unchanged;
+}
+
+void FunctionCheckCache::Update(const ValidationState_t& _) {
+  std::vector<uint32_t> module_words;
+  std::vector<FunctionWords> functions;
+  SplitModule(_, &module_words, &functions);
+
+  module_words_ = std::move(module_words);
+  functions_.clear();
+  for (FunctionWords& function : functions) {
+    functions_.insert(std::move(function.words));
+  }
+}
+
+}  // namespace val
+}  // namespace spvtools
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_VAL_FUNCTION_CHECK_CACHE_H_
+#define SOURCE_VAL_FUNCTION_CHECK_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace spvtools {
+namespace val {
+
+class ValidationState_t;
+
+// Remembers the last module that passed validation, so that validating a
+// slightly different module, such as the same module after an optimization
+// pass, can skip the control flow and dominance checks of the functions that
+// did not change.
+//
+// A function is unchanged if its words, from OpFunction to OpFunctionEnd, are
+// identical to those of a function in the recorded module, and every word of
+// the module outside of its functions is identical too. The control flow and
+// dominance checks of such a function only depend on those words, so they
+// must give the same result as before.
+//
+// A cache must only be used with one set of validator options, and by one
+// validation at a time.
+class FunctionCheckCache {
+ public:
+  // Returns the ids of the functions in |_| that are unchanged from the
+  // recorded module. Returns an empty set if nothing has been recorded, or if
+  // anything outside of the functions has changed.
+  std::unordered_set<uint32_t> FindUnchangedFunctions(
+      const ValidationState_t& _) const;
+
+  // Records the module in |_|, which has passed validation, replacing the
+  // module recorded before.
+  void Update(const ValidationState_t& _);
+
+ private:
+  struct WordsHash {
+    size_t operator()(const std::vector<uint32_t>& words) const;
+  };
+
+  // The version of the recorded module, followed by the words of all of its
+  // instructions outside of functions.
+  std::vector<uint32_t> module_words_;
+  // The words of each function of the recorded module.
+  std::unordered_set<std::vector<uint32_t>, WordsHash> functions_;
+};
+
+}  // namespace val
+}  // namespace spvtools
+
+#endif  // SOURCE_VAL_FUNCTION_CHECK_CACHE_H_
@@ -29,6 +29,7 @@
 #include "source/spirv_target_env.h"
 #include "source/table2.h"
 #include "source/val/construct.h"
+#include "source/val/function_check_cache.h"
 #include "source/val/instruction.h"
 #include "source/val/validation_state.h"
 #include "spirv-tools/libspirv.h"
@@ -351,6 +352,13 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   // can be relied on in subsequent passes.
   ReachabilityPass(*vstate);
 
+  // Functions that are unchanged since the last module validated with the
+  // same cache skip the control flow and dominance checks.
+  FunctionCheckCache* cache = vstate->options()->function_check_cache;
+  if (cache) {
+    vstate->set_unchanged_functions(cache->FindUnchangedFunctions(*vstate));
+  }
+
   // ID usage needs be handled in its own iteration of the instructions,
   // between the two others. It depends on the first loop to have been
   // finished, so that all instructions have been registered. And the following
@@ -368,43 +376,12 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
     auto& instruction = vstate->ordered_instructions()[i];
 
-    // Keep these passes in the order they appear in the SPIR-V specification
-    // sections to maintain test consistency.
-    if (auto error = MiscPass(*vstate, &instruction)) return error;
-    if (auto error = DebugPass(*vstate, &instruction)) return error;
-    if (auto error = AnnotationPass(*vstate, &instruction)) return error;
-    if (auto error = ExtensionPass(*vstate, &instruction)) return error;
-    if (auto error = ModeSettingPass(*vstate, &instruction)) return error;
-    if (auto error = TypePass(*vstate, &instruction)) return error;
-    if (auto error = ConstantPass(*vstate, &instruction)) return error;
-    if (auto error = MemoryPass(*vstate, &instruction)) return error;
-    if (auto error = FunctionPass(*vstate, &instruction)) return error;
-    if (auto error = ImagePass(*vstate, &instruction)) return error;
-    if (auto error = ConversionPass(*vstate, &instruction)) return error;
-    if (auto error = CompositesPass(*vstate, &instruction)) return error;
-    if (auto error = ArithmeticsPass(*vstate, &instruction)) return error;
-    if (auto error = BitwisePass(*vstate, &instruction)) return error;
-    if (auto error = LogicalsPass(*vstate, &instruction)) return error;
-    if (auto error = ControlFlowPass(*vstate, &instruction)) return error;
-    if (auto error = DerivativesPass(*vstate, &instruction)) return error;
-    if (auto error = AtomicsPass(*vstate, &instruction)) return error;
-    if (auto error = PrimitivesPass(*vstate, &instruction)) return error;
-    if (auto error = BarriersPass(*vstate, &instruction)) return error;
-    // Group
-    // Device-Side Enqueue
-    // Pipe
-    if (auto error = NonUniformPass(*vstate, &instruction)) return error;
-
-    if (auto error = LiteralsPass(*vstate, &instruction)) return error;
-    if (auto error = RayQueryPass(*vstate, &instruction)) return error;
-    if (auto error = RayTracingPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderNVPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderEXTPass(*vstate, &instruction)) return error;
-    if (auto error = MeshShadingPass(*vstate, &instruction)) return error;
-    if (auto error = TensorLayoutPass(*vstate, &instruction)) return error;
-    if (auto error = TensorPass(*vstate, &instruction)) return error;
-    if (auto error = GraphPass(*vstate, &instruction)) return error;
-    if (auto error = InvalidTypePass(*vstate, &instruction)) return error;
+    // Only run the passes that handle this opcode. The table keeps them in
+    // the order they appear in the SPIR-V specification sections.
+    for (InstructionPass pass :
+         InstructionPassesForOpcode(instruction.opcode())) {
+      if (auto error = pass(*vstate, &instruction)) return error;
+    }
   }
 
   // Validate the preconditions involving adjacent instructions. e.g.
@@ -420,8 +397,8 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   if (auto error = CheckIdDefinitionDominateUse(*vstate)) return error;
   if (auto error = ValidateDecorations(*vstate)) return error;
   if (auto error = ValidateInterfaces(*vstate)) return error;
-  // TODO(dsinclair): Restructure ValidateBuiltins so we can move into the
-  // for() above as it loops over all ordered_instructions internally.
+  // Built-in checks only visit the ids with a BuiltIn decoration and the
+  // instructions that depend on them, so they do not scan the module again.
   if (auto error = ValidateBuiltIns(*vstate)) return error;
   // These checks must be performed after individual opcode checks because
   // those checks register the limitation checked here.
@@ -433,6 +410,8 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   }
   if (auto error = ValidateLogicalPointers(*vstate)) return error;
 
+  if (cache) cache->Update(*vstate);
+
   return SPV_SUCCESS;
 }
 
@@ -241,6 +241,22 @@ void ReachabilityPass(ValidationState_t& _);
 /// Validates tensor layout and view instructions.
 spv_result_t TensorLayoutPass(ValidationState_t& _, const Instruction* inst);
 
+/// A pass that validates a single instruction, such as MemoryPass.
+using InstructionPass = spv_result_t (*)(ValidationState_t& _,
+                                         const Instruction* inst);
+
+/// @brief Returns the opcode passes that may do any work for |opcode|
+///
+/// The passes are listed in the order they must run, which follows the
+/// sections of the SPIR-V specification. Every other opcode pass returns
+/// SPV_SUCCESS for |opcode| without looking at the instruction, so running
+/// only the listed passes gives the same result as running all of them.
+///
+/// @param[in] opcode the opcode of the instruction to validate
+///
+/// @return the passes to run on instructions with |opcode|
+const std::vector<InstructionPass>& InstructionPassesForOpcode(spv::Op opcode);
+
 /// Validates execution limitations.
 ///
 /// Verifies execution models are allowed for all functionality they contain.
@@ -283,6 +299,10 @@ spv_result_t spvValidateIDs(const spv_instruction_t* pInstructions,
 // The main difference between this API and spvValidateBinary is that the
 // "Validation State" is not destroyed upon function return; it lives on and is
 // pointed to by the vstate unique_ptr.
+//
+// The instructions in |*vstate| refer to |words| instead of copying them, so
+// |words| must outlive |*vstate|. The one exception is a binary that is not in
+// host endianness: its words are byte-swapped into storage owned by |*vstate|.
 spv_result_t ValidateBinaryAndKeepValidationState(
     const spv_const_context context, spv_const_validator_options options,
     const uint32_t* words, const size_t num_words, spv_diagnostic* pDiagnostic,
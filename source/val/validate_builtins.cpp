@@ -21,10 +21,12 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <queue>
 #include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "source/opcode.h"
@@ -692,31 +694,14 @@ class BuiltInsValidator {
 
   uint64_t GetArrayLength(uint32_t interface_var_id);
 
-  // Updates inner working of the class. Is called sequentially for every
-  // instruction.
+  // Sets the function whose context the reference checks run in to the
+  // function containing |inst|. Is called for every instruction that
+  // references an id with checks, in module order.
   void Update(const Instruction& inst);
 
   bool IsBulitinInEntryPoint(const Instruction& inst, uint32_t entry_point) {
-    auto get_underlying_type_id = [&](const Instruction* ifx_var) {
-      auto pointer_type_inst = _.FindDef(ifx_var->type_id());
-      auto type_inst = _.FindDef(pointer_type_inst->GetOperandAs<uint32_t>(2));
-      while (type_inst->opcode() == spv::Op::OpTypeArray) {
-        type_inst = _.FindDef(type_inst->GetOperandAs<uint32_t>(1));
-      };
-      return type_inst->id();
-    };
-
-    for (const auto& desc : _.entry_point_descriptions(entry_point)) {
-      for (auto interface : desc.interfaces) {
-        if (inst.opcode() == spv::Op::OpTypeStruct) {
-          auto varInst = _.FindDef(interface);
-          if (inst.id() == get_underlying_type_id(varInst)) {
-            return true;
-          }
-        } else if (inst.id() == interface) {
-          return true;
-        }
-      }
+    for (const auto& use : FindEntryPointInterfaces(inst)) {
+      if (use.entry_point == entry_point) return true;
     }
     return false;
   }
@@ -727,38 +712,40 @@ class BuiltInsValidator {
   bool IsMeshInterfaceVar(
       const Instruction& inst,
       std::map<uint32_t, uint32_t>& entry_point_interface_id) {
-    auto get_underlying_type_id = [&](const Instruction* ifx_var) {
-      auto pointer_type_inst = _.FindDef(ifx_var->type_id());
-      auto type_inst = _.FindDef(pointer_type_inst->GetOperandAs<uint32_t>(2));
-      while (type_inst->opcode() == spv::Op::OpTypeArray) {
-        type_inst = _.FindDef(type_inst->GetOperandAs<uint32_t>(1));
-      };
-      return type_inst->id();
-    };
-
-    for (const uint32_t entry_point : _.entry_points()) {
-      const auto* models = _.GetExecutionModels(entry_point);
+    const EntryPointInterface* previous = nullptr;
+    for (const auto& use : FindEntryPointInterfaces(inst)) {
+      // Only the first interface of each description that refers to "inst"
+      // is recorded.
+      const bool same_description =
+          previous && previous->entry_point == use.entry_point &&
+          previous->description == use.description;
+      previous = &use;
+      if (same_description) continue;
+      const auto* models = _.GetExecutionModels(use.entry_point);
       if (models->find(spv::ExecutionModel::MeshEXT) != models->end() ||
           models->find(spv::ExecutionModel::MeshNV) != models->end()) {
-        for (const auto& desc : _.entry_point_descriptions(entry_point)) {
-          for (auto interface : desc.interfaces) {
-            if (inst.opcode() == spv::Op::OpTypeStruct) {
-              auto varInst = _.FindDef(interface);
-              if (inst.id() == get_underlying_type_id(varInst)) {
-                entry_point_interface_id[entry_point] = interface;
-                break;
-              }
-            } else if (inst.id() == interface) {
-              entry_point_interface_id[entry_point] = interface;
-              break;
-            }
-          }
-        }
+        entry_point_interface_id[use.entry_point] = use.interface;
       }
     }
     return !entry_point_interface_id.empty();
   }
 
+  // An interface listed by description number |description| of
+  // |entry_point|.
+  struct EntryPointInterface {
+    uint32_t entry_point;
+    size_t description;
+    uint32_t interface;
+  };
+
+  // Returns the entry point interfaces that are "inst", or, if "inst" is a
+  // struct type, whose variables hold "inst", possibly in arrays. They are in
+  // the order of the entry points, their descriptions and their interfaces.
+  // The index is built on first use, so each query costs only the number of
+  // interfaces that refer to "inst".
+  const std::vector<EntryPointInterface>& FindEntryPointInterfaces(
+      const Instruction& inst);
+
   ValidationState_t& _;
 
   // Mapping id -> list of rules which validate instruction referencing the
@@ -783,32 +770,86 @@ class BuiltInsValidator {
   // For Builtin that can only be declared once in an entry point, keep track if
   // the entry point has it already
   std::set<uint32_t> cull_primitive_entry_points_;
+
+  // Entry point interfaces by the id of the interface variable, and by the
+  // struct type the variable holds. See FindEntryPointInterfaces().
+  std::unordered_map<uint32_t, std::vector<EntryPointInterface>>
+      interfaces_by_variable_;
+  std::unordered_map<uint32_t, std::vector<EntryPointInterface>>
+      interfaces_by_struct_;
+  bool interface_index_built_ = false;
+  const std::vector<EntryPointInterface> no_interfaces_;
 };
 
 void BuiltInsValidator::Update(const Instruction& inst) {
-  const spv::Op opcode = inst.opcode();
-  if (opcode == spv::Op::OpFunction) {
-    // Entering a function.
-    assert(function_id_ == 0);
-    function_id_ = inst.id();
-    execution_models_.clear();
-    entry_points_ = &_.FunctionEntryPoints(function_id_);
-    // Collect execution models from all entry points from which the current
-    // function can be called.
-    for (const uint32_t entry_point : *entry_points_) {
-      if (const auto* models = _.GetExecutionModels(entry_point)) {
-        execution_models_.insert(models->begin(), models->end());
-      }
+  // OpFunction is checked inside the function it declares, and OpFunctionEnd
+  // outside of it.
+  uint32_t function_id = 0;
+  if (inst.opcode() == spv::Op::OpFunction) {
+    function_id = inst.id();
+  } else if (inst.opcode() != spv::Op::OpFunctionEnd && inst.function()) {
+    function_id = inst.function()->id();
+  }
+  if (function_id == function_id_) return;
+
+  function_id_ = function_id;
+  execution_models_.clear();
+  if (function_id_ == 0) {
+    entry_points_ = &no_entry_points;
+    return;
+  }
+  entry_points_ = &_.FunctionEntryPoints(function_id_);
+  // Collect execution models from all entry points from which the current
+  // function can be called.
+  for (const uint32_t entry_point : *entry_points_) {
+    if (const auto* models = _.GetExecutionModels(entry_point)) {
+      execution_models_.insert(models->begin(), models->end());
     }
   }
+}
 
-  if (opcode == spv::Op::OpFunctionEnd) {
-    // Exiting a function.
-    assert(function_id_ != 0);
-    function_id_ = 0;
-    entry_points_ = &no_entry_points;
-    execution_models_.clear();
+const std::vector<BuiltInsValidator::EntryPointInterface>&
+BuiltInsValidator::FindEntryPointInterfaces(const Instruction& inst) {
+  if (!interface_index_built_) {
+    interface_index_built_ = true;
+    // Returns the type held by the interface variable |var|, looking through
+    // arrays, or 0 if |var| is not a variable of a typed pointer.
+    auto get_underlying_type_id = [this](uint32_t var) -> uint32_t {
+      const Instruction* var_inst = _.FindDef(var);
+      if (!var_inst) return 0;
+      const Instruction* pointer_type_inst = _.FindDef(var_inst->type_id());
+      if (!pointer_type_inst ||
+          pointer_type_inst->opcode() != spv::Op::OpTypePointer) {
+        return 0;
+      }
+      auto type_inst = _.FindDef(pointer_type_inst->GetOperandAs<uint32_t>(2));
+      while (type_inst->opcode() == spv::Op::OpTypeArray) {
+        type_inst = _.FindDef(type_inst->GetOperandAs<uint32_t>(1));
+      }
+      return type_inst->id();
+    };
+
+    std::unordered_set<uint32_t> seen_entry_points;
+    for (const uint32_t entry_point : _.entry_points()) {
+      if (!seen_entry_points.insert(entry_point).second) continue;
+      const auto& descs = _.entry_point_descriptions(entry_point);
+      for (size_t i = 0; i < descs.size(); ++i) {
+        for (const uint32_t interface : descs[i].interfaces) {
+          const EntryPointInterface use = {entry_point, i, interface};
+          interfaces_by_variable_[interface].push_back(use);
+          if (const uint32_t type_id = get_underlying_type_id(interface)) {
+            interfaces_by_struct_[type_id].push_back(use);
+          }
+        }
+      }
+    }
   }
+
+  const auto& index = inst.opcode() == spv::Op::OpTypeStruct
+                          ? interfaces_by_struct_
+                          : interfaces_by_variable_;
+  const auto it = index.find(inst.id());
+  return it == index.end() ? no_interfaces_ : it->second;
 }
 
 std::string BuiltInsValidator::GetDefinitionDesc(
@@ -5028,17 +5069,12 @@ spv_result_t BuiltInsValidator::ValidateSingleBuiltInAtDefinitionVulkan(
 }
 
 spv_result_t BuiltInsValidator::ValidateBuiltInsAtDefinition() {
-  for (const auto& kv : _.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
-    if (decorations.empty()) {
-      continue;
-    }
-
+  for (const uint32_t id : _.builtin_decorated_ids()) {
+    const auto& decorations = *_.FindDecorations(id);
     const Instruction* inst = _.FindDef(id);
     assert(inst);
 
-    for (const auto& decoration : kv.second) {
+    for (const auto& decoration : decorations) {
       if (decoration.dec_type() != spv::Decoration::BuiltIn) {
         continue;
       }
@@ -5065,9 +5101,38 @@ spv_result_t BuiltInsValidator::Run() {
     return SPV_SUCCESS;
   }
 
-  // Second pass: validate every id reference in the module using
-  // rules in id_to_at_reference_checks_.
-  for (const Instruction& inst : _.ordered_instructions()) {
+  // Second pass: validate the references to the ids with checks using the
+  // rules in id_to_at_reference_checks_. Only the instructions that use such
+  // an id are visited, in module order. Checks may add rules for the id
+  // defined by the instruction being visited; its uses that come later in the
+  // module are then visited too.
+  const auto& instructions = _.ordered_instructions();
+  std::vector<bool> queued(instructions.size(), false);
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>>
+      pending;
+  // Queues the uses of |id| at or after position |first| in the module.
+  auto queue_uses = [&_, &queued, &pending](uint32_t id, size_t first) {
+    const Instruction* def = _.FindDef(id);
+    if (!def) return;
+    for (const auto& use : def->uses()) {
+      // Instructions are numbered from 1 in module order.
+      const size_t position = use.first->LineNum() - 1;
+      if (position >= first && !queued[position]) {
+        queued[position] = true;
+        pending.push(position);
+      }
+    }
+  };
+  for (const auto& id_and_checks : id_to_at_reference_checks_) {
+    queue_uses(id_and_checks.first, 0);
+  }
+
+  while (!pending.empty()) {
+    const size_t position = pending.top();
+    pending.pop();
+    const Instruction& inst = instructions[position];
+    const bool had_checks = inst.id() != 0 &&
+                            id_to_at_reference_checks_.count(inst.id()) != 0;
     Update(inst);
 
     std::set<uint32_t> already_checked;
@@ -5101,6 +5166,12 @@ spv_result_t BuiltInsValidator::Run() {
         }
       }
     }
+
+    // Uses of an id that already had checks are queued already.
+    if (!had_checks && inst.id() != 0 &&
+        id_to_at_reference_checks_.count(inst.id()) != 0) {
+      queue_uses(inst.id(), position + 1);
+    }
   }
 
   return SPV_SUCCESS;
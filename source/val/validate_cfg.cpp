@@ -975,8 +975,122 @@ spv_result_t MaximalReconvergenceChecks(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+namespace {
+
+// The dominance information PerformCfgChecks needs for one function, beyond
+// what is recorded on its blocks.
+struct FunctionDominance {
+  // The blocks of the augmented structural CFG in post order.
+  std::vector<const BasicBlock*> structural_postorder;
+  // The back edges of the function, as (from, to) block ids.
+  std::vector<std::pair<uint32_t, uint32_t>> back_edges;
+};
+
+// Sets the immediate dominator of each block of |function| and, if
+// |structured| is true, its immediate structural dominator and post
+// dominator. Records the remaining results in |dominance|.
+//
+// This only reads and writes state that belongs to |function|, so it may run
+// for several functions at once.
+void CalculateDominance(Function& function, bool structured,
+                        FunctionDominance* dominance) {
+  if (function.ordered_blocks().empty()) return;
+
+  // We want to analyze all the blocks in the function, even in degenerate
+  // control flow cases including unreachable blocks.  So use the augmented
+  // CFG to ensure we cover all the blocks.
+  std::vector<const BasicBlock*> postorder;
+  auto ignore_block = [](const BasicBlock*) {};
+  auto no_terminal_blocks = [](const BasicBlock*) { return false; };
+  /// calculate dominators
+  CFA<BasicBlock>::DepthFirstTraversal(
+      function.first_block(), function.AugmentedCFGSuccessorsFunction(),
+      ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
+      no_terminal_blocks);
+  auto edges = CFA<BasicBlock>::CalculateDominators(
+      postorder, function.AugmentedCFGPredecessorsFunction());
+  for (auto edge : edges) {
+    if (edge.first != edge.second)
+      edge.first->SetImmediateDominator(edge.second);
+  }
+
+  /// Structured control flow checks are only required for shader capabilities
+  if (!structured) return;
+
+  // Calculate structural dominance.
+  postorder.clear();
+  std::vector<const BasicBlock*> postdom_postorder;
+  /// calculate dominators
+  CFA<BasicBlock>::DepthFirstTraversal(
+      function.first_block(),
+      function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+      [&](const BasicBlock* b) { postorder.push_back(b); },
+      no_terminal_blocks);
+  edges = CFA<BasicBlock>::CalculateDominators(
+      postorder, function.AugmentedStructuralCFGPredecessorsFunction());
+  for (auto edge : edges) {
+    if (edge.first != edge.second)
+      edge.first->SetImmediateStructuralDominator(edge.second);
+  }
+
+  /// calculate post dominators
+  CFA<BasicBlock>::DepthFirstTraversal(
+      function.pseudo_exit_block(),
+      function.AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
+      [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
+      no_terminal_blocks);
+  auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
+      postdom_postorder, function.AugmentedStructuralCFGSuccessorsFunction());
+  for (auto edge : postdom_edges) {
+    edge.first->SetImmediateStructuralPostDominator(edge.second);
+  }
+  /// calculate back edges.
+  auto& back_edges = dominance->back_edges;
+  CFA<BasicBlock>::DepthFirstTraversal(
+      function.pseudo_entry_block(),
+      function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+      ignore_block,
+      [&](const BasicBlock* from, const BasicBlock* to) {
+        // A back edge must be a real edge. Since the augmented successors
+        // contain structural edges, filter those from consideration.
+        for (const auto* succ : *(from->successors())) {
+          if (succ == to) back_edges.emplace_back(from->id(), to->id());
+        }
+      },
+      no_terminal_blocks);
+  dominance->structural_postorder = std::move(postorder);
+}
+
+}  // namespace
+
 spv_result_t PerformCfgChecks(ValidationState_t& _) {
+  const bool structured = _.HasCapability(spv::Capability::Shader);
+
+  // The dominator trees of different functions are independent, so they are
+  // built up front, on the thread pool if there is one. The checks below then
+  // run in function order on this thread, so that the first error reported
+  // does not depend on the number of threads. Functions that are unchanged
+  // since an earlier module passed these checks are skipped.
+  std::vector<Function*> functions;
   for (auto& function : _.functions()) {
+    if (!_.IsUnchangedFunction(function.id())) functions.push_back(&function);
+  }
+  std::vector<FunctionDominance> dominance(functions.size());
+  auto calculate = [&functions, &dominance, structured](size_t i) {
+    // Functions with undefined blocks are rejected below without looking at
+    // their dominators.
+    if (functions[i]->undefined_block_count() != 0) return;
+    CalculateDominance(*functions[i], structured, &dominance[i]);
+    functions[i]->ComputeDominatorIntervals();
+  };
+  if (auto* pool = _.thread_pool()) {
+    pool->ParallelFor(functions.size(), calculate);
+  } else {
+    for (size_t i = 0; i < functions.size(); ++i) calculate(i);
+  }
+
+  for (size_t i = 0; i < functions.size(); ++i) {
+    Function& function = *functions[i];
     // Check all referenced blocks are defined within a function
     if (function.undefined_block_count() != 0) {
       std::string undef_blocks("{");
@@ -994,38 +1108,22 @@ spv_result_t PerformCfgChecks(ValidationState_t& _) {
              << _.getIdName(function.id());
     }
 
-    // Set each block's immediate dominator.
-    //
-    // We want to analyze all the blocks in the function, even in degenerate
-    // control flow cases including unreachable blocks.  So use the augmented
-    // CFG to ensure we cover all the blocks.
-    std::vector<const BasicBlock*> postorder;
-    auto ignore_block = [](const BasicBlock*) {};
-    auto no_terminal_blocks = [](const BasicBlock*) { return false; };
-    if (!function.ordered_blocks().empty()) {
-      /// calculate dominators
-      CFA<BasicBlock>::DepthFirstTraversal(
-          function.first_block(), function.AugmentedCFGSuccessorsFunction(),
-          ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
-          no_terminal_blocks);
-      auto edges = CFA<BasicBlock>::CalculateDominators(
-          postorder, function.AugmentedCFGPredecessorsFunction());
-      for (auto edge : edges) {
-        if (edge.first != edge.second)
-          edge.first->SetImmediateDominator(edge.second);
-      }
-    }
-
     auto& blocks = function.ordered_blocks();
     if (!blocks.empty()) {
       // Check if the order of blocks in the binary appear before the blocks
       // they dominate
-      for (auto block = begin(blocks) + 1; block != end(blocks); ++block) {
-        if (auto idom = (*block)->immediate_dominator()) {
+      std::unordered_map<const BasicBlock*, size_t> block_positions;
+      for (size_t j = 0; j < blocks.size(); ++j) {
+        block_positions.emplace(blocks[j], j);
+      }
+      for (size_t j = 1; j < blocks.size(); ++j) {
+        if (auto idom = blocks[j]->immediate_dominator()) {
+          auto idom_position = block_positions.find(idom);
           if (idom != function.pseudo_entry_block() &&
-              block == std::find(begin(blocks), block, idom)) {
+              (idom_position == block_positions.end() ||
+               idom_position->second >= j)) {
             return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(idom->id()))
-                   << "Block " << _.getIdName((*block)->id())
+                   << "Block " << _.getIdName(blocks[j]->id())
                    << " appears in the binary before its dominator "
                    << _.getIdName(idom->id());
           }
@@ -1033,7 +1131,7 @@ spv_result_t PerformCfgChecks(ValidationState_t& _) {
       }
       // If we have structured control flow, check that no block has a control
       // flow nesting depth larger than the limit.
-      if (_.HasCapability(spv::Capability::Shader)) {
+      if (structured) {
         const int control_flow_nesting_depth_limit =
             _.options()->universal_limits_.max_control_flow_nesting_depth;
         for (auto block = begin(blocks); block != end(blocks); ++block) {
@@ -1047,55 +1145,12 @@ spv_result_t PerformCfgChecks(ValidationState_t& _) {
     }
 
     /// Structured control flow checks are only required for shader capabilities
-    if (_.HasCapability(spv::Capability::Shader)) {
-      // Calculate structural dominance.
-      postorder.clear();
-      std::vector<const BasicBlock*> postdom_postorder;
-      std::vector<std::pair<uint32_t, uint32_t>> back_edges;
-      if (!function.ordered_blocks().empty()) {
-        /// calculate dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.first_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postorder.push_back(b); },
-            no_terminal_blocks);
-        auto edges = CFA<BasicBlock>::CalculateDominators(
-            postorder, function.AugmentedStructuralCFGPredecessorsFunction());
-        for (auto edge : edges) {
-          if (edge.first != edge.second)
-            edge.first->SetImmediateStructuralDominator(edge.second);
-        }
-
-        /// calculate post dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_exit_block(),
-            function.AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
-            no_terminal_blocks);
-        auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
-            postdom_postorder,
-            function.AugmentedStructuralCFGSuccessorsFunction());
-        for (auto edge : postdom_edges) {
-          edge.first->SetImmediateStructuralPostDominator(edge.second);
-        }
-        /// calculate back edges.
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_entry_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            ignore_block,
-            [&](const BasicBlock* from, const BasicBlock* to) {
-              // A back edge must be a real edge. Since the augmented successors
-              // contain structural edges, filter those from consideration.
-              for (const auto* succ : *(from->successors())) {
-                if (succ == to) back_edges.emplace_back(from->id(), to->id());
-              }
-            },
-            no_terminal_blocks);
-      }
-      UpdateContinueConstructExitBlocks(function, back_edges);
+    if (structured) {
+      UpdateContinueConstructExitBlocks(function, dominance[i].back_edges);
 
-      if (auto error =
-              StructuredControlFlowChecks(_, &function, back_edges, postorder))
+      if (auto error = StructuredControlFlowChecks(
+              _, &function, dominance[i].back_edges,
+              dominance[i].structural_postorder))
         return error;
     }
   }
@@ -26,6 +26,7 @@
 #include "source/spirv_constant.h"
 #include "source/spirv_target_env.h"
 #include "source/spirv_validator_options.h"
+#include "source/util/hash_combine.h"
 #include "source/util/string_utils.h"
 #include "source/val/validate_scopes.h"
 #include "source/val/validation_state.h"
@@ -61,6 +62,39 @@ struct LayoutConstraints {
 using MemberConstraints = std::unordered_map<std::pair<uint32_t, uint32_t>,
                                              LayoutConstraints, PairHash>;
 
+// Identifies one layout computation for a type: the type id, the layout
+// constraints it inherits from the struct member that holds it, and whether
+// structs, arrays and matrices are rounded up to 16 bytes.
+struct LayoutKey {
+  uint32_t type_id;
+  MatrixLayout majorness;
+  uint32_t matrix_stride;
+  bool round_up;
+
+  bool operator==(const LayoutKey& other) const {
+    return type_id == other.type_id && majorness == other.majorness &&
+           matrix_stride == other.matrix_stride && round_up == other.round_up;
+  }
+};
+
+struct LayoutKeyHash {
+  std::size_t operator()(const LayoutKey& key) const {
+    return utils::hash_combine(0, key.type_id, uint32_t(key.majorness),
+                               key.matrix_stride, key.round_up);
+  }
+};
+
+// Layout information shared by every block checked in a module. The member
+// constraints of a struct only depend on its own decorations, so they, and the
+// alignments and sizes derived from them, are the same for every variable and
+// layout rule that reaches the struct. Each is computed once.
+struct LayoutCache {
+  MemberConstraints constraints;
+  std::unordered_map<LayoutKey, uint32_t, LayoutKeyHash> base_alignments;
+  std::unordered_map<uint32_t, uint32_t> scalar_alignments;
+  std::unordered_map<LayoutKey, uint32_t, LayoutKeyHash> sizes;
+};
+
 // Returns the array stride of the given array type.
 uint32_t GetArrayStride(uint32_t array_id, ValidationState_t& vstate) {
   for (auto& decoration : vstate.id_decorations(array_id)) {
@@ -152,14 +186,18 @@ uint32_t align(uint32_t x, uint32_t alignment) {
   return (x + alignment - 1) & ~(alignment - 1);
 }
 
-// Returns base alignment of struct member. If |roundUp| is true, also
-// ensure that structs, arrays, and matrices are aligned at least to a
-// multiple of 16 bytes.  (That is, when roundUp is true, this function
-// returns the *extended* alignment as it's called by the Vulkan spec.)
 uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
                           const LayoutConstraints& inherited,
-                          MemberConstraints& constraints,
-                          ValidationState_t& vstate) {
+                          LayoutCache& cache, ValidationState_t& vstate);
+uint32_t getScalarAlignment(uint32_t type_id, LayoutCache& cache,
+                            ValidationState_t& vstate);
+uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
+                 LayoutCache& cache, ValidationState_t& vstate);
+
+// Computes the result of getBaseAlignment when it is not in the cache.
+uint32_t computeBaseAlignment(uint32_t member_id, bool roundUp,
+                              const LayoutConstraints& inherited,
+                              LayoutCache& cache, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   // Minimal alignment is byte-aligned.
@@ -180,7 +218,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       const auto componentId = words[2];
       const auto numComponents = words[3];
       const auto componentAlignment = getBaseAlignment(
-          componentId, roundUp, inherited, constraints, vstate);
+          componentId, roundUp, inherited, cache, vstate);
       baseAlignment =
           componentAlignment *
           ((numComponents == 3 || numComponents > 4) ? 4 : numComponents);
@@ -191,7 +229,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       const auto numComponents = vstate.GetDimension(inst->id());
       assert(numComponents != 0);
       const auto componentAlignment = getBaseAlignment(
-          componentId, roundUp, inherited, constraints, vstate);
+          componentId, roundUp, inherited, cache, vstate);
       baseAlignment =
           componentAlignment *
           ((numComponents == 3 || numComponents > 4) ? 4 : numComponents);
@@ -201,7 +239,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       const auto column_type = words[2];
       if (inherited.majorness == kColumnMajor) {
         baseAlignment = getBaseAlignment(column_type, roundUp, inherited,
-                                         constraints, vstate);
+                                         cache, vstate);
       } else {
         // A row-major matrix of C columns has a base alignment equal to the
         // base alignment of a vector of C matrix components.
@@ -209,7 +247,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
         const auto component_inst = vstate.FindDef(column_type);
         const auto component_id = component_inst->words()[2];
         const auto componentAlignment = getBaseAlignment(
-            component_id, roundUp, inherited, constraints, vstate);
+            component_id, roundUp, inherited, cache, vstate);
         baseAlignment =
             componentAlignment * (num_columns == 3 ? 4 : num_columns);
       }
@@ -218,7 +256,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
     case spv::Op::OpTypeArray:
     case spv::Op::OpTypeRuntimeArray:
       baseAlignment =
-          getBaseAlignment(words[2], roundUp, inherited, constraints, vstate);
+          getBaseAlignment(words[2], roundUp, inherited, cache, vstate);
       if (roundUp) baseAlignment = align(baseAlignment, 16u);
       break;
     case spv::Op::OpTypeStruct: {
@@ -227,10 +265,10 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
            memberIdx < numMembers; ++memberIdx) {
         const auto id = members[memberIdx];
         const auto& constraint =
-            constraints[std::make_pair(member_id, memberIdx)];
+            cache.constraints[std::make_pair(member_id, memberIdx)];
         baseAlignment = std::max(
             baseAlignment,
-            getBaseAlignment(id, roundUp, constraint, constraints, vstate));
+            getBaseAlignment(id, roundUp, constraint, cache, vstate));
       }
       if (roundUp) baseAlignment = align(baseAlignment, 16u);
       break;
@@ -247,8 +285,26 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
   return baseAlignment;
 }
 
-// Returns scalar alignment of a type.
-uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
+// Returns base alignment of struct member. If |roundUp| is true, also
+// ensure that structs, arrays, and matrices are aligned at least to a
+// multiple of 16 bytes.  (That is, when roundUp is true, this function
+// returns the *extended* alignment as it's called by the Vulkan spec.)
+uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
+                          const LayoutConstraints& inherited,
+                          LayoutCache& cache, ValidationState_t& vstate) {
+  // The matrix stride does not affect alignment.
+  const LayoutKey key{member_id, inherited.majorness, 0, roundUp};
+  const auto it = cache.base_alignments.find(key);
+  if (it != cache.base_alignments.end()) return it->second;
+  const uint32_t alignment =
+      computeBaseAlignment(member_id, roundUp, inherited, cache, vstate);
+  cache.base_alignments.emplace(key, alignment);
+  return alignment;
+}
+
+// Computes the result of getScalarAlignment when it is not in the cache.
+uint32_t computeScalarAlignment(uint32_t type_id, LayoutCache& cache,
+                                ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(type_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -268,7 +324,7 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
     case spv::Op::OpTypeArray:
     case spv::Op::OpTypeRuntimeArray: {
       const auto compositeMemberTypeId = words[2];
-      return getScalarAlignment(compositeMemberTypeId, vstate);
+      return getScalarAlignment(compositeMemberTypeId, cache, vstate);
     }
     case spv::Op::OpTypeStruct: {
       const auto members = getStructMembers(type_id, vstate);
@@ -276,7 +332,7 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
       for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
            memberIdx < numMembers; ++memberIdx) {
         const auto id = members[memberIdx];
-        uint32_t member_alignment = getScalarAlignment(id, vstate);
+        uint32_t member_alignment = getScalarAlignment(id, cache, vstate);
         if (member_alignment > max_member_alignment) {
           max_member_alignment = member_alignment;
         }
@@ -294,10 +350,19 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
   return 1;
 }
 
-// Returns size of a struct member. Doesn't include padding at the end of struct
-// or array.  Assumes that in the struct case, all members have offsets.
-uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
-                 MemberConstraints& constraints, ValidationState_t& vstate) {
+// Returns scalar alignment of a type.
+uint32_t getScalarAlignment(uint32_t type_id, LayoutCache& cache,
+                            ValidationState_t& vstate) {
+  const auto it = cache.scalar_alignments.find(type_id);
+  if (it != cache.scalar_alignments.end()) return it->second;
+  const uint32_t alignment = computeScalarAlignment(type_id, cache, vstate);
+  cache.scalar_alignments.emplace(type_id, alignment);
+  return alignment;
+}
+
+// Computes the result of getSize when it is not in the cache.
+uint32_t computeSize(uint32_t member_id, const LayoutConstraints& inherited,
+                     LayoutCache& cache, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -314,8 +379,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
     case spv::Op::OpTypeVector: {
       const auto componentId = words[2];
       const auto numComponents = words[3];
-      const auto componentSize =
-          getSize(componentId, inherited, constraints, vstate);
+      const auto componentSize = getSize(componentId, inherited, cache, vstate);
       const auto size = componentSize * numComponents;
       return size;
     }
@@ -323,8 +387,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       const auto componentId = words[2];
       const auto numComponents = vstate.GetDimension(inst->id());
       assert(numComponents != 0);
-      const auto componentSize =
-          getSize(componentId, inherited, constraints, vstate);
+      const auto componentSize = getSize(componentId, inherited, cache, vstate);
       const auto size = componentSize * numComponents;
       return size;
     }
@@ -334,8 +397,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       assert(spv::Op::OpConstant == sizeInst->opcode());
       const uint32_t num_elem = sizeInst->words()[3];
       const uint32_t elem_type = words[2];
-      const uint32_t elem_size =
-          getSize(elem_type, inherited, constraints, vstate);
+      const uint32_t elem_size = getSize(elem_type, inherited, cache, vstate);
       // Account for gaps due to alignments in the first N-1 elements,
       // then add the size of the last element.
       const auto size =
@@ -355,7 +417,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
         const auto num_rows = component_inst->words()[3];
         const auto scalar_elem_type = component_inst->words()[2];
         const uint32_t scalar_elem_size =
-            getSize(scalar_elem_type, inherited, constraints, vstate);
+            getSize(scalar_elem_type, inherited, cache, vstate);
         return (num_rows - 1) * inherited.matrix_stride +
                num_columns * scalar_elem_size;
       }
@@ -379,8 +441,9 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       // This check depends on the fact that all members have offsets.  This
       // has been checked earlier in the flow.
       assert(offset != 0xffffffff);
-      const auto& constraint = constraints[std::make_pair(lastMember, lastIdx)];
-      return offset + getSize(lastMember, constraint, constraints, vstate);
+      const auto& constraint =
+          cache.constraints[std::make_pair(lastMember, lastIdx)];
+      return offset + getSize(lastMember, constraint, cache, vstate);
     }
     case spv::Op::OpTypePointer:
     case spv::Op::OpTypeUntypedPointerKHR:
@@ -391,6 +454,19 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
   }
 }
 
+// Returns size of a struct member. Doesn't include padding at the end of struct
+// or array.  Assumes that in the struct case, all members have offsets.
+uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
+                 LayoutCache& cache, ValidationState_t& vstate) {
+  const LayoutKey key{member_id, inherited.majorness, inherited.matrix_stride,
+                      false};
+  const auto it = cache.sizes.find(key);
+  if (it != cache.sizes.end()) return it->second;
+  const uint32_t size = computeSize(member_id, inherited, cache, vstate);
+  cache.sizes.emplace(key, size);
+  return size;
+}
+
 // A member is defined to improperly straddle if either of the following are
 // true:
 // - It is a vector with total size less than or equal to 16 bytes, and has
@@ -400,9 +476,8 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
 // decorations placing its first byte at a non-integer multiple of 16.
 bool hasImproperStraddle(uint32_t id, uint32_t offset,
                          const LayoutConstraints& inherited,
-                         MemberConstraints& constraints,
-                         ValidationState_t& vstate) {
-  const auto size = getSize(id, inherited, constraints, vstate);
+                         LayoutCache& cache, ValidationState_t& vstate) {
+  const auto size = getSize(id, inherited, cache, vstate);
   const auto F = offset;
   const auto L = offset + size - 1;
   if (size <= 16) {
@@ -427,8 +502,7 @@ bool IsAlignedTo(uint32_t offset, uint32_t alignment) {
 spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
                          const char* decoration_str, bool blockRules,
                          bool scalar_block_layout, uint32_t incoming_offset,
-                         MemberConstraints& constraints,
-                         ValidationState_t& vstate) {
+                         LayoutCache& cache, ValidationState_t& vstate) {
   if (vstate.options()->skip_block_layout) return SPV_SUCCESS;
 
   // blockRules are the same as bufferBlock rules if the uniform buffer
@@ -542,17 +616,17 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
     const auto offset = member_offset.offset;
     auto id = members[member_offset.member];
     const LayoutConstraints& constraint =
-        constraints[std::make_pair(struct_id, uint32_t(memberIdx))];
+        cache.constraints[std::make_pair(struct_id, uint32_t(memberIdx))];
     // Scalar layout takes precedence because it's more permissive, and implying
     // an alignment that divides evenly into the alignment that would otherwise
     // be used.
     const auto alignment =
         scalar_block_layout
-            ? getScalarAlignment(id, vstate)
-            : getBaseAlignment(id, blockRules, constraint, constraints, vstate);
+            ? getScalarAlignment(id, cache, vstate)
+            : getBaseAlignment(id, blockRules, constraint, cache, vstate);
     const auto inst = vstate.FindDef(id);
     const auto opcode = inst->opcode();
-    const auto size = getSize(id, constraint, constraints, vstate);
+    const auto size = getSize(id, constraint, cache, vstate);
     // Check offset.
     if (offset == 0xffffffff)
       return fail(memberIdx) << "is missing an Offset decoration" << extra();
@@ -571,7 +645,8 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
       // In relaxed block layout, the vector offset must be aligned to the
       // vector's scalar element type.
       const auto componentId = inst->words()[2];
-      const auto scalar_alignment = getScalarAlignment(componentId, vstate);
+      const auto scalar_alignment =
+          getScalarAlignment(componentId, cache, vstate);
       if (!IsAlignedTo(offset, scalar_alignment)) {
         return fail(memberIdx) << "at offset " << offset
                                << " is not aligned to scalar element size "
@@ -593,7 +668,7 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
       // Check improper straddle of vectors.
       if ((spv::Op::OpTypeVector == opcode ||
            spv::Op::OpTypeVectorIdEXT == opcode) &&
-          hasImproperStraddle(id, offset, constraint, constraints, vstate))
+          hasImproperStraddle(id, offset, constraint, cache, vstate))
         return fail(memberIdx)
                << "is an improperly straddling vector at offset " << offset
                << extra();
@@ -603,7 +678,7 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
     if (spv::Op::OpTypeStruct == opcode &&
         SPV_SUCCESS != (recursive_status = checkLayout(
                             id, storage_class, decoration_str, blockRules,
-                            scalar_block_layout, offset, constraints, vstate)))
+                            scalar_block_layout, offset, cache, vstate)))
       return recursive_status;
     // Check matrix stride.
     if (spv::Op::OpTypeMatrix == opcode) {
@@ -662,7 +737,7 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
           if (SPV_SUCCESS !=
               (recursive_status = checkLayout(
                    typeId, storage_class, decoration_str, blockRules,
-                   scalar_block_layout, next_offset, constraints, vstate)))
+                   scalar_block_layout, next_offset, cache, vstate)))
             return recursive_status;
 
           seen[next_offset % 16] = true;
@@ -679,13 +754,14 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
 
       // Proceed to the element in case it is an array.
       array_inst = element_inst;
-      array_alignment = scalar_block_layout
-                            ? getScalarAlignment(array_inst->id(), vstate)
-                            : getBaseAlignment(array_inst->id(), blockRules,
-                                               constraint, constraints, vstate);
+      array_alignment =
+          scalar_block_layout
+              ? getScalarAlignment(array_inst->id(), cache, vstate)
+              : getBaseAlignment(array_inst->id(), blockRules, constraint,
+                                 cache, vstate);
 
       const auto element_size =
-          getSize(element_inst->id(), constraint, constraints, vstate);
+          getSize(element_inst->id(), constraint, cache, vstate);
       if (element_size > array_stride) {
         return fail(memberIdx)
                << "contains an array with stride " << array_stride
@@ -1238,12 +1314,14 @@ spv_result_t CheckDecorationsOfVariables(ValidationState_t& vstate) {
 spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
   // Set of entry points that are known to use a push constant.
   std::unordered_set<uint32_t> uses_push_constant;
+  // Shared by all the variables, so that the layout of each type is only
+  // computed once.
+  LayoutCache cache;
   for (const auto& inst : vstate.ordered_instructions()) {
     const auto& words = inst.words();
     auto type_id = inst.type_id();
     const Instruction* type_inst = vstate.FindDef(type_id);
     bool scalar_block_layout = false;
-    MemberConstraints constraints;
     if (spv::Op::OpVariable == inst.opcode() ||
         spv::Op::OpUntypedVariableKHR == inst.opcode()) {
       const bool untyped_pointer =
@@ -1321,7 +1399,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
           }
           // Struct requirement is checked on variables so just move on here.
           if (spv::Op::OpTypeStruct != id_inst->opcode()) continue;
-          ComputeMemberConstraintsForStruct(&constraints, id,
+          ComputeMemberConstraintsForStruct(&cache.constraints, id,
                                             LayoutConstraints(), vstate);
         }
 
@@ -1439,13 +1517,13 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
                     (SPV_SUCCESS !=
                      (recursive_status = checkLayout(
                           id, storageClass, deco_str, true, scalar_block_layout,
-                          0, constraints, vstate)))) {
+                          0, cache, vstate)))) {
                   return recursive_status;
                 } else if (bufferRules &&
                            (SPV_SUCCESS != (recursive_status = checkLayout(
                                                 id, storageClass, deco_str,
                                                 false, scalar_block_layout, 0,
-                                                constraints, vstate)))) {
+                                                cache, vstate)))) {
                   return recursive_status;
                 }
               }
@@ -1461,12 +1539,12 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
       const auto* data_type_inst = vstate.FindDef(pointee_type_id);
       scalar_block_layout = vstate.options()->scalar_block_layout;
       if (data_type_inst->opcode() == spv::Op::OpTypeStruct) {
-        ComputeMemberConstraintsForStruct(&constraints, pointee_type_id,
+        ComputeMemberConstraintsForStruct(&cache.constraints, pointee_type_id,
                                           LayoutConstraints(), vstate);
       }
       if (auto res = checkLayout(
               pointee_type_id, spv::StorageClass::PhysicalStorageBuffer,
-              "Block", !buffer, scalar_block_layout, 0, constraints, vstate)) {
+              "Block", !buffer, scalar_block_layout, 0, cache, vstate)) {
         return res;
       }
     } else if (vstate.HasCapability(spv::Capability::UntypedPointersKHR) &&
@@ -1546,7 +1624,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
           bufferRules =
               vstate.HasDecoration(data_type_id, spv::Decoration::BufferBlock);
         }
-        ComputeMemberConstraintsForStruct(&constraints, data_type_id,
+        ComputeMemberConstraintsForStruct(&cache.constraints, data_type_id,
                                           LayoutConstraints(), vstate);
       }
       const char* deco_str =
@@ -1555,7 +1633,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
               : "Block";
       if (auto result =
               checkLayout(data_type_id, sc, deco_str, !bufferRules,
-                          scalar_block_layout, 0, constraints, vstate)) {
+                          scalar_block_layout, 0, cache, vstate)) {
         return result;
       }
     }
@@ -2099,9 +2177,8 @@ spv_result_t CheckDecorationsFromDecoration(ValidationState_t& vstate) {
   // Some rules are only checked for shaders.
   const bool is_shader = vstate.HasCapability(spv::Capability::Shader);
 
-  for (const auto& kv : vstate.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
+  for (const uint32_t id : vstate.DecoratedIds()) {
+    const auto& decorations = *vstate.FindDecorations(id);
     if (decorations.empty()) continue;
 
     const Instruction* inst = vstate.FindDef(id);
@@ -2201,16 +2278,14 @@ spv::Decoration UsesExplicitLayout(
       type_inst->opcode() == spv::Op::OpTypeRuntimeArray ||
       type_inst->opcode() == spv::Op::OpTypePointer ||
       type_inst->opcode() == spv::Op::OpTypeUntypedPointerKHR) {
-    const auto& id_decs = vstate.id_decorations();
-    const auto iter = id_decs.find(type_id);
-    if (iter != id_decs.end()) {
+    if (const auto* decorations = vstate.FindDecorations(type_id)) {
       bool allowLayoutDecorations = false;
       if (type_inst->opcode() == spv::Op::OpTypePointer) {
         const auto sc = type_inst->GetOperandAs<spv::StorageClass>(1);
         allowLayoutDecorations = AllowsLayout(vstate, sc);
       }
       if (!allowLayoutDecorations) {
-        for (const auto& d : iter->second) {
+        for (const auto& d : *decorations) {
           const spv::Decoration dec = d.dec_type();
           if (dec == spv::Decoration::Block ||
               dec == spv::Decoration::BufferBlock ||
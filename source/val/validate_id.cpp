@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <unordered_set>
 #include <vector>
 
@@ -39,6 +40,60 @@ spv_result_t UpdateIdUse(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+namespace {
+
+// Returns the first use of the id defined by |inst| that is not dominated by
+// its definition, or that lies outside the function defining it. Returns
+// nullptr if every use is valid. OpPhi users are appended to |phis| instead,
+// since they are checked against the parent block of each incoming value.
+//
+// Uses within a function that is unchanged since an earlier validation are
+// not checked again, and its blocks have no dominators.
+//
+// This does not modify any state, so it may run for several instructions at
+// once.
+const Instruction* FindInvalidUse(const ValidationState_t& _,
+                                  const Instruction& inst,
+                                  std::vector<const Instruction*>* phis) {
+  if (inst.id() == 0) return nullptr;
+  const Function* func = inst.function();
+  if (!func) return nullptr;
+  if (const BasicBlock* block = inst.block()) {
+    const bool unchanged = _.IsUnchangedFunction(func->id());
+    // If the Id is defined within a block then make sure all references to
+    // that Id appear in a blocks that are dominated by the defining block
+    for (auto& use_index_pair : inst.uses()) {
+      const Instruction* use = use_index_pair.first;
+      if (unchanged && use->function() == func) continue;
+      if (const BasicBlock* use_block = use->block()) {
+        if (use_block->reachable() == false) continue;
+        if (use->opcode() == spv::Op::OpPhi) {
+          phis->push_back(use);
+        } else if (!block->dominates(*use_block)) {
+          return use;
+        }
+      }
+    }
+  } else {
+    // If the Ids defined within a function but not in a block(i.e. function
+    // parameters, block ids), then make sure all references to that Id
+    // appear within the same function
+    for (auto use : inst.uses()) {
+      const Instruction* user = use.first;
+      if (user->function() && user->function() != func) return user;
+    }
+  }
+  // NOTE: Ids defined outside of functions must appear before they are used
+  // This check is being performed in the IdPass function
+  return nullptr;
+}
+
+// The number of instructions CheckIdDefinitionDominateUse hands to a thread
+// at a time.
+const size_t kDominanceChunkSize = 1024;
+
+}  // namespace
+
 /// This function checks all ID definitions dominate their use in the CFG.
 ///
 /// This function will iterate over all ID definitions that are defined in the
@@ -48,49 +103,67 @@ spv_result_t UpdateIdUse(ValidationState_t& _, const Instruction* inst) {
 /// NOTE: This function does NOT check module scoped functions which are
 /// checked during the initial binary parse in the IdPass below
 spv_result_t CheckIdDefinitionDominateUse(ValidationState_t& _) {
+  const auto& instructions = _.ordered_instructions();
+
+  // The instructions are scanned in chunks, on the thread pool if there is
+  // one. Each chunk stops at its first invalid use, and the chunks are then
+  // combined in order, so the error reported is the one a single scan over
+  // the whole module would find first.
+  struct Chunk {
+    const Instruction* def = nullptr;
+    const Instruction* use = nullptr;
+    std::vector<const Instruction*> phis;
+  };
+  const size_t num_chunks =
+      (instructions.size() + kDominanceChunkSize - 1) / kDominanceChunkSize;
+  std::vector<Chunk> chunks(num_chunks);
+  auto scan = [&_, &instructions, &chunks](size_t c) {
+    Chunk& chunk = chunks[c];
+    const size_t end =
+        std::min(instructions.size(), (c + 1) * kDominanceChunkSize);
+    for (size_t i = c * kDominanceChunkSize; i < end; ++i) {
+      const Instruction* use = FindInvalidUse(_, instructions[i], &chunk.phis);
+      if (use) {
+        chunk.def = &instructions[i];
+        chunk.use = use;
+        return;
+      }
+    }
+  };
+  if (auto* pool = _.thread_pool()) {
+    pool->ParallelFor(num_chunks, scan);
+  } else {
+    for (size_t c = 0; c < num_chunks; ++c) {
+      scan(c);
+      if (chunks[c].use) break;
+    }
+  }
+
   std::vector<const Instruction*> phi_instructions;
   std::unordered_set<uint32_t> phi_ids;
-  for (const auto& inst : _.ordered_instructions()) {
-    if (inst.id() == 0) continue;
-    if (const Function* func = inst.function()) {
+  for (const Chunk& chunk : chunks) {
+    if (const Instruction* use = chunk.use) {
+      const Instruction& inst = *chunk.def;
       if (const BasicBlock* block = inst.block()) {
-        // If the Id is defined within a block then make sure all references to
-        // that Id appear in a blocks that are dominated by the defining block
-        for (auto& use_index_pair : inst.uses()) {
-          const Instruction* use = use_index_pair.first;
-          if (const BasicBlock* use_block = use->block()) {
-            if (use_block->reachable() == false) continue;
-            if (use->opcode() == spv::Op::OpPhi) {
-              if (phi_ids.insert(use->id()).second) {
-                phi_instructions.push_back(use);
-              }
-            } else if (!block->dominates(*use->block())) {
-              return _.diag(SPV_ERROR_INVALID_ID, use_block->label())
-                     << "ID " << _.getIdName(inst.id()) << " defined in block "
-                     << _.getIdName(block->id())
-                     << " does not dominate its use in block "
-                     << _.getIdName(use_block->id());
-            }
-          }
-        }
-      } else {
-        // If the Ids defined within a function but not in a block(i.e. function
-        // parameters, block ids), then make sure all references to that Id
-        // appear within the same function
-        for (auto use : inst.uses()) {
-          const Instruction* user = use.first;
-          if (user->function() && user->function() != func) {
-            return _.diag(SPV_ERROR_INVALID_ID, _.FindDef(func->id()))
-                   << "ID " << _.getIdName(inst.id()) << " used in function "
-                   << _.getIdName(user->function()->id())
-                   << " is used outside of it's defining function "
-                   << _.getIdName(func->id());
-          }
-        }
+        const BasicBlock* use_block = use->block();
+        return _.diag(SPV_ERROR_INVALID_ID, use_block->label())
+               << "ID " << _.getIdName(inst.id()) << " defined in block "
+               << _.getIdName(block->id())
+               << " does not dominate its use in block "
+               << _.getIdName(use_block->id());
+      }
+      const Function* func = inst.function();
+      return _.diag(SPV_ERROR_INVALID_ID, _.FindDef(func->id()))
+             << "ID " << _.getIdName(inst.id()) << " used in function "
+             << _.getIdName(use->function()->id())
+             << " is used outside of it's defining function "
+             << _.getIdName(func->id());
+    }
+    for (const Instruction* phi : chunk.phis) {
+      if (phi_ids.insert(phi->id()).second) {
+        phi_instructions.push_back(phi);
       }
     }
-    // NOTE: Ids defined outside of functions must appear before they are used
-    // This check is being performed in the IdPass function
   }
 
   // Check all OpPhi parent blocks are dominated by the variable's defining
@@ -0,0 +1,412 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Maps every opcode to the opcode passes that handle it, so that the
+// validator does not call each of the ~30 passes for every instruction.
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+#include "source/opcode.h"
+#include "source/val/validate.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+// Opcodes occupy the low 16 bits of the first word of an instruction.
+const uint32_t kNumOpcodes = 1u << 16;
+
+bool AnyOpcode(spv::Op) { return true; }
+
+bool GeneratesType(spv::Op opcode) {
+  return spvOpcodeGeneratesType(opcode) != 0;
+}
+
+bool IsConstant(spv::Op opcode) { return spvOpcodeIsConstant(opcode) != 0; }
+
+// The passes that handle each opcode.
+class PassTable {
+ public:
+  PassTable();
+
+  // Returns the passes that handle |opcode|, in the order they must run.
+  const std::vector<InstructionPass>& passes(spv::Op opcode) const {
+    const uint32_t index = static_cast<uint32_t>(opcode);
+    if (index >= kNumOpcodes) return passes_;
+    return lists_[list_index_[index]];
+  }
+
+ private:
+  // Appends |pass| to the passes, and records that it handles |opcodes| and
+  // the opcodes for which |filter| returns true.
+  void Add(InstructionPass pass, std::initializer_list<spv::Op> opcodes,
+           bool (*filter)(spv::Op) = nullptr);
+
+  // All of the passes, in the order they must run.
+  std::vector<InstructionPass> passes_;
+  // While the table is built, the set of passes that handle each opcode, as a
+  // mask of indices into |passes_|.
+  std::vector<uint32_t> masks_;
+  // The distinct lists of passes, and the index of the list for each opcode.
+  std::vector<std::vector<InstructionPass>> lists_;
+  std::vector<uint8_t> list_index_;
+};
+
+// When a case is added to the opcode switch of a pass, the opcode must also
+// be added to the pass here. Otherwise the pass never sees instructions with
+// that opcode.
+PassTable::PassTable() : masks_(kNumOpcodes, 0) {
+  // Keep these passes in the order they appear in the SPIR-V specification
+  // sections to maintain test consistency.
+  Add(MiscPass,
+      {spv::Op::OpUndef, spv::Op::OpBeginInvocationInterlockEXT,
+       spv::Op::OpEndInvocationInterlockEXT,
+       spv::Op::OpDemoteToHelperInvocationEXT, spv::Op::OpIsHelperInvocationEXT,
+       spv::Op::OpReadClockKHR, spv::Op::OpAssumeTrueKHR,
+       spv::Op::OpExpectKHR});
+  Add(DebugPass, {spv::Op::OpMemberName, spv::Op::OpLine});
+  Add(AnnotationPass,
+      {spv::Op::OpDecorate, spv::Op::OpDecorateId, spv::Op::OpMemberDecorate,
+       spv::Op::OpDecorationGroup, spv::Op::OpGroupDecorate,
+       spv::Op::OpGroupMemberDecorate});
+  Add(ExtensionPass, {spv::Op::OpExtension, spv::Op::OpExtInstImport},
+      spvIsExtendedInstruction);
+  Add(ModeSettingPass,
+      {spv::Op::OpEntryPoint, spv::Op::OpExecutionMode,
+       spv::Op::OpExecutionModeId, spv::Op::OpMemoryModel,
+       spv::Op::OpCapability});
+  Add(TypePass, {spv::Op::OpTypeForwardPointer}, GeneratesType);
+  // ConstantPass ends with a check that applies to every constant opcode.
+  Add(ConstantPass, {}, IsConstant);
+  Add(MemoryPass,
+      {spv::Op::OpVariable, spv::Op::OpUntypedVariableKHR, spv::Op::OpLoad,
+       spv::Op::OpStore, spv::Op::OpCopyMemory, spv::Op::OpCopyMemorySized,
+       spv::Op::OpPtrAccessChain, spv::Op::OpUntypedPtrAccessChainKHR,
+       spv::Op::OpUntypedInBoundsPtrAccessChainKHR, spv::Op::OpAccessChain,
+       spv::Op::OpInBoundsAccessChain, spv::Op::OpInBoundsPtrAccessChain,
+       spv::Op::OpUntypedAccessChainKHR,
+       spv::Op::OpUntypedInBoundsAccessChainKHR, spv::Op::OpRawAccessChainNV,
+       spv::Op::OpArrayLength, spv::Op::OpUntypedArrayLengthKHR,
+       spv::Op::OpCooperativeMatrixLoadNV, spv::Op::OpCooperativeMatrixStoreNV,
+       spv::Op::OpCooperativeMatrixLengthKHR,
+       spv::Op::OpCooperativeMatrixLengthNV,
+       spv::Op::OpCooperativeMatrixLoadKHR,
+       spv::Op::OpCooperativeMatrixStoreKHR,
+       spv::Op::OpCooperativeMatrixLoadTensorNV,
+       spv::Op::OpCooperativeMatrixStoreTensorNV,
+       spv::Op::OpCooperativeVectorLoadNV, spv::Op::OpCooperativeVectorStoreNV,
+       spv::Op::OpCooperativeVectorOuterProductAccumulateNV,
+       spv::Op::OpCooperativeVectorReduceSumAccumulateNV,
+       spv::Op::OpCooperativeVectorMatrixMulNV,
+       spv::Op::OpCooperativeVectorMatrixMulAddNV, spv::Op::OpPtrEqual,
+       spv::Op::OpPtrNotEqual, spv::Op::OpPtrDiff, spv::Op::OpImageTexelPointer,
+       spv::Op::OpGenericPtrMemSemantics});
+  Add(FunctionPass,
+      {spv::Op::OpFunction, spv::Op::OpFunctionParameter,
+       spv::Op::OpFunctionCall, spv::Op::OpCooperativeMatrixPerElementOpNV});
+  Add(ImagePass,
+      {spv::Op::OpTypeImage, spv::Op::OpTypeSampledImage,
+       spv::Op::OpSampledImage, spv::Op::OpImageTexelPointer,
+       spv::Op::OpImageSampleImplicitLod, spv::Op::OpImageSampleExplicitLod,
+       spv::Op::OpImageSampleProjImplicitLod,
+       spv::Op::OpImageSampleProjExplicitLod,
+       spv::Op::OpImageSparseSampleImplicitLod,
+       spv::Op::OpImageSparseSampleExplicitLod,
+       spv::Op::OpImageSampleDrefImplicitLod,
+       spv::Op::OpImageSampleDrefExplicitLod,
+       spv::Op::OpImageSampleProjDrefImplicitLod,
+       spv::Op::OpImageSampleProjDrefExplicitLod,
+       spv::Op::OpImageSparseSampleDrefImplicitLod,
+       spv::Op::OpImageSparseSampleDrefExplicitLod, spv::Op::OpImageFetch,
+       spv::Op::OpImageSparseFetch, spv::Op::OpImageGather,
+       spv::Op::OpImageDrefGather, spv::Op::OpImageSparseGather,
+       spv::Op::OpImageSparseDrefGather, spv::Op::OpImageRead,
+       spv::Op::OpImageSparseRead, spv::Op::OpImageWrite, spv::Op::OpImage,
+       spv::Op::OpImageQueryFormat, spv::Op::OpImageQueryOrder,
+       spv::Op::OpImageQuerySizeLod, spv::Op::OpImageQuerySize,
+       spv::Op::OpImageQueryLod, spv::Op::OpImageQueryLevels,
+       spv::Op::OpImageQuerySamples,
+       spv::Op::OpImageSparseSampleProjImplicitLod,
+       spv::Op::OpImageSparseSampleProjExplicitLod,
+       spv::Op::OpImageSparseSampleProjDrefImplicitLod,
+       spv::Op::OpImageSparseSampleProjDrefExplicitLod,
+       spv::Op::OpImageSparseTexelsResident, spv::Op::OpImageSampleWeightedQCOM,
+       spv::Op::OpImageBoxFilterQCOM, spv::Op::OpImageBlockMatchSSDQCOM,
+       spv::Op::OpImageBlockMatchSADQCOM,
+       spv::Op::OpImageBlockMatchWindowSADQCOM,
+       spv::Op::OpImageBlockMatchWindowSSDQCOM,
+       spv::Op::OpImageBlockMatchGatherSADQCOM,
+       spv::Op::OpImageBlockMatchGatherSSDQCOM});
+  Add(ConversionPass,
+      {spv::Op::OpConvertFToU, spv::Op::OpConvertFToS, spv::Op::OpConvertSToF,
+       spv::Op::OpConvertUToF, spv::Op::OpUConvert, spv::Op::OpSConvert,
+       spv::Op::OpFConvert, spv::Op::OpQuantizeToF16, spv::Op::OpConvertPtrToU,
+       spv::Op::OpSatConvertSToU, spv::Op::OpSatConvertUToS,
+       spv::Op::OpConvertUToPtr, spv::Op::OpPtrCastToGeneric,
+       spv::Op::OpGenericCastToPtr, spv::Op::OpGenericCastToPtrExplicit,
+       spv::Op::OpBitcast, spv::Op::OpConvertUToAccelerationStructureKHR,
+       spv::Op::OpCooperativeMatrixConvertNV,
+       spv::Op::OpCooperativeMatrixTransposeNV, spv::Op::OpBitCastArrayQCOM});
+  Add(CompositesPass,
+      {spv::Op::OpVectorExtractDynamic, spv::Op::OpVectorInsertDynamic,
+       spv::Op::OpVectorShuffle, spv::Op::OpCompositeConstruct,
+       spv::Op::OpCompositeExtract, spv::Op::OpCompositeInsert,
+       spv::Op::OpCopyObject, spv::Op::OpTranspose, spv::Op::OpCopyLogical,
+       spv::Op::OpCompositeConstructCoopMatQCOM,
+       spv::Op::OpCompositeExtractCoopMatQCOM, spv::Op::OpExtractSubArrayQCOM});
+  Add(ArithmeticsPass,
+      {spv::Op::OpFAdd, spv::Op::OpFSub, spv::Op::OpFMul, spv::Op::OpFDiv,
+       spv::Op::OpFRem, spv::Op::OpFMod, spv::Op::OpFNegate, spv::Op::OpFmaKHR,
+       spv::Op::OpUDiv, spv::Op::OpUMod, spv::Op::OpISub, spv::Op::OpIAdd,
+       spv::Op::OpIMul, spv::Op::OpSDiv, spv::Op::OpSMod, spv::Op::OpSRem,
+       spv::Op::OpSNegate, spv::Op::OpDot, spv::Op::OpVectorTimesScalar,
+       spv::Op::OpMatrixTimesScalar, spv::Op::OpVectorTimesMatrix,
+       spv::Op::OpMatrixTimesVector, spv::Op::OpMatrixTimesMatrix,
+       spv::Op::OpOuterProduct, spv::Op::OpIAddCarry, spv::Op::OpISubBorrow,
+       spv::Op::OpUMulExtended, spv::Op::OpSMulExtended,
+       spv::Op::OpCooperativeMatrixMulAddNV,
+       spv::Op::OpCooperativeMatrixMulAddKHR,
+       spv::Op::OpCooperativeMatrixReduceNV});
+  Add(BitwisePass,
+      {spv::Op::OpShiftRightLogical, spv::Op::OpShiftRightArithmetic,
+       spv::Op::OpShiftLeftLogical, spv::Op::OpBitwiseOr, spv::Op::OpBitwiseXor,
+       spv::Op::OpBitwiseAnd, spv::Op::OpNot, spv::Op::OpBitFieldInsert,
+       spv::Op::OpBitFieldSExtract, spv::Op::OpBitFieldUExtract,
+       spv::Op::OpBitReverse, spv::Op::OpBitCount});
+  Add(LogicalsPass,
+      {spv::Op::OpAny, spv::Op::OpAll, spv::Op::OpIsNan, spv::Op::OpIsInf,
+       spv::Op::OpIsFinite, spv::Op::OpIsNormal, spv::Op::OpSignBitSet,
+       spv::Op::OpFOrdEqual, spv::Op::OpFUnordEqual, spv::Op::OpFOrdNotEqual,
+       spv::Op::OpFUnordNotEqual, spv::Op::OpFOrdLessThan,
+       spv::Op::OpFUnordLessThan, spv::Op::OpFOrdGreaterThan,
+       spv::Op::OpFUnordGreaterThan, spv::Op::OpFOrdLessThanEqual,
+       spv::Op::OpFUnordLessThanEqual, spv::Op::OpFOrdGreaterThanEqual,
+       spv::Op::OpFUnordGreaterThanEqual, spv::Op::OpLessOrGreater,
+       spv::Op::OpOrdered, spv::Op::OpUnordered, spv::Op::OpLogicalEqual,
+       spv::Op::OpLogicalNotEqual, spv::Op::OpLogicalOr, spv::Op::OpLogicalAnd,
+       spv::Op::OpLogicalNot, spv::Op::OpSelect, spv::Op::OpIEqual,
+       spv::Op::OpINotEqual, spv::Op::OpUGreaterThan,
+       spv::Op::OpUGreaterThanEqual, spv::Op::OpULessThan,
+       spv::Op::OpULessThanEqual, spv::Op::OpSGreaterThan,
+       spv::Op::OpSGreaterThanEqual, spv::Op::OpSLessThan,
+       spv::Op::OpSLessThanEqual});
+  Add(ControlFlowPass,
+      {spv::Op::OpPhi, spv::Op::OpBranch, spv::Op::OpBranchConditional,
+       spv::Op::OpReturnValue, spv::Op::OpSwitch, spv::Op::OpLoopMerge});
+  Add(DerivativesPass,
+      {spv::Op::OpDPdx, spv::Op::OpDPdy, spv::Op::OpFwidth, spv::Op::OpDPdxFine,
+       spv::Op::OpDPdyFine, spv::Op::OpFwidthFine, spv::Op::OpDPdxCoarse,
+       spv::Op::OpDPdyCoarse, spv::Op::OpFwidthCoarse});
+  Add(AtomicsPass,
+      {spv::Op::OpAtomicLoad, spv::Op::OpAtomicStore, spv::Op::OpAtomicExchange,
+       spv::Op::OpAtomicFAddEXT, spv::Op::OpAtomicCompareExchange,
+       spv::Op::OpAtomicCompareExchangeWeak, spv::Op::OpAtomicIIncrement,
+       spv::Op::OpAtomicIDecrement, spv::Op::OpAtomicIAdd,
+       spv::Op::OpAtomicISub, spv::Op::OpAtomicSMin, spv::Op::OpAtomicUMin,
+       spv::Op::OpAtomicFMinEXT, spv::Op::OpAtomicSMax, spv::Op::OpAtomicUMax,
+       spv::Op::OpAtomicFMaxEXT, spv::Op::OpAtomicAnd, spv::Op::OpAtomicOr,
+       spv::Op::OpAtomicXor, spv::Op::OpAtomicFlagTestAndSet,
+       spv::Op::OpAtomicFlagClear});
+  Add(PrimitivesPass,
+      {spv::Op::OpEmitVertex, spv::Op::OpEndPrimitive,
+       spv::Op::OpEmitStreamVertex, spv::Op::OpEndStreamPrimitive});
+  Add(BarriersPass,
+      {spv::Op::OpControlBarrier, spv::Op::OpMemoryBarrier,
+       spv::Op::OpNamedBarrierInitialize, spv::Op::OpMemoryNamedBarrier});
+  // Group
+  // Device-Side Enqueue
+  // Pipe
+  Add(NonUniformPass, {}, spvOpcodeIsNonUniformGroupOperation);
+
+  Add(LiteralsPass, {}, AnyOpcode);
+  Add(RayQueryPass,
+      {spv::Op::OpRayQueryInitializeKHR, spv::Op::OpRayQueryTerminateKHR,
+       spv::Op::OpRayQueryConfirmIntersectionKHR,
+       spv::Op::OpRayQueryGenerateIntersectionKHR,
+       spv::Op::OpRayQueryGetIntersectionFrontFaceKHR,
+       spv::Op::OpRayQueryProceedKHR,
+       spv::Op::OpRayQueryGetIntersectionCandidateAABBOpaqueKHR,
+       spv::Op::OpRayQueryGetIntersectionTKHR, spv::Op::OpRayQueryGetRayTMinKHR,
+       spv::Op::OpRayQueryGetIntersectionTypeKHR,
+       spv::Op::OpRayQueryGetIntersectionInstanceCustomIndexKHR,
+       spv::Op::OpRayQueryGetIntersectionInstanceIdKHR,
+       spv::Op::OpRayQueryGetIntersectionGeometryIndexKHR,
+       spv::Op::OpRayQueryGetIntersectionPrimitiveIndexKHR,
+       spv::Op::OpRayQueryGetRayFlagsKHR,
+       spv::Op::OpRayQueryGetIntersectionObjectRayDirectionKHR,
+       spv::Op::OpRayQueryGetIntersectionObjectRayOriginKHR,
+       spv::Op::OpRayQueryGetWorldRayDirectionKHR,
+       spv::Op::OpRayQueryGetWorldRayOriginKHR,
+       spv::Op::OpRayQueryGetIntersectionBarycentricsKHR,
+       spv::Op::OpRayQueryGetIntersectionObjectToWorldKHR,
+       spv::Op::OpRayQueryGetIntersectionWorldToObjectKHR,
+       spv::Op::OpRayQueryGetClusterIdNV,
+       spv::Op::OpRayQueryGetIntersectionSpherePositionNV,
+       spv::Op::OpRayQueryGetIntersectionLSSPositionsNV,
+       spv::Op::OpRayQueryGetIntersectionLSSRadiiNV,
+       spv::Op::OpRayQueryGetIntersectionSphereRadiusNV,
+       spv::Op::OpRayQueryGetIntersectionLSSHitValueNV,
+       spv::Op::OpRayQueryIsSphereHitNV, spv::Op::OpRayQueryIsLSSHitNV});
+  Add(RayTracingPass,
+      {spv::Op::OpTraceRayKHR, spv::Op::OpReportIntersectionKHR,
+       spv::Op::OpExecuteCallableKHR});
+  Add(RayReorderNVPass,
+      {spv::Op::OpHitObjectIsMissNV, spv::Op::OpHitObjectIsHitNV,
+       spv::Op::OpHitObjectIsEmptyNV,
+       spv::Op::OpHitObjectGetShaderRecordBufferHandleNV,
+       spv::Op::OpHitObjectGetHitKindNV,
+       spv::Op::OpHitObjectGetPrimitiveIndexNV,
+       spv::Op::OpHitObjectGetGeometryIndexNV,
+       spv::Op::OpHitObjectGetInstanceIdNV,
+       spv::Op::OpHitObjectGetInstanceCustomIndexNV,
+       spv::Op::OpHitObjectGetShaderBindingTableRecordIndexNV,
+       spv::Op::OpHitObjectGetCurrentTimeNV, spv::Op::OpHitObjectGetRayTMaxNV,
+       spv::Op::OpHitObjectGetRayTMinNV, spv::Op::OpHitObjectGetObjectToWorldNV,
+       spv::Op::OpHitObjectGetWorldToObjectNV,
+       spv::Op::OpHitObjectGetObjectRayOriginNV,
+       spv::Op::OpHitObjectGetObjectRayDirectionNV,
+       spv::Op::OpHitObjectGetWorldRayDirectionNV,
+       spv::Op::OpHitObjectGetWorldRayOriginNV,
+       spv::Op::OpHitObjectGetAttributesNV, spv::Op::OpHitObjectExecuteShaderNV,
+       spv::Op::OpHitObjectRecordEmptyNV, spv::Op::OpHitObjectRecordMissNV,
+       spv::Op::OpHitObjectRecordHitWithIndexNV,
+       spv::Op::OpHitObjectRecordHitNV, spv::Op::OpHitObjectTraceRayMotionNV,
+       spv::Op::OpHitObjectTraceRayNV, spv::Op::OpReorderThreadWithHitObjectNV,
+       spv::Op::OpReorderThreadWithHintNV, spv::Op::OpHitObjectGetClusterIdNV,
+       spv::Op::OpHitObjectGetSpherePositionNV,
+       spv::Op::OpHitObjectGetSphereRadiusNV,
+       spv::Op::OpHitObjectGetLSSPositionsNV, spv::Op::OpHitObjectGetLSSRadiiNV,
+       spv::Op::OpHitObjectIsSphereHitNV, spv::Op::OpHitObjectIsLSSHitNV});
+  Add(RayReorderEXTPass,
+      {spv::Op::OpHitObjectIsMissEXT, spv::Op::OpHitObjectIsHitEXT,
+       spv::Op::OpHitObjectIsEmptyEXT,
+       spv::Op::OpHitObjectGetShaderRecordBufferHandleEXT,
+       spv::Op::OpHitObjectGetHitKindEXT,
+       spv::Op::OpHitObjectGetPrimitiveIndexEXT,
+       spv::Op::OpHitObjectGetGeometryIndexEXT,
+       spv::Op::OpHitObjectGetInstanceIdEXT,
+       spv::Op::OpHitObjectGetInstanceCustomIndexEXT,
+       spv::Op::OpHitObjectGetShaderBindingTableRecordIndexEXT,
+       spv::Op::OpHitObjectGetRayFlagsEXT,
+       spv::Op::OpHitObjectGetCurrentTimeEXT, spv::Op::OpHitObjectGetRayTMaxEXT,
+       spv::Op::OpHitObjectGetRayTMinEXT,
+       spv::Op::OpHitObjectGetObjectToWorldEXT,
+       spv::Op::OpHitObjectGetWorldToObjectEXT,
+       spv::Op::OpHitObjectGetObjectRayOriginEXT,
+       spv::Op::OpHitObjectGetObjectRayDirectionEXT,
+       spv::Op::OpHitObjectGetWorldRayDirectionEXT,
+       spv::Op::OpHitObjectGetWorldRayOriginEXT,
+       spv::Op::OpHitObjectGetIntersectionTriangleVertexPositionsEXT,
+       spv::Op::OpHitObjectGetAttributesEXT,
+       spv::Op::OpHitObjectSetShaderBindingTableRecordIndexEXT,
+       spv::Op::OpHitObjectExecuteShaderEXT, spv::Op::OpHitObjectRecordEmptyEXT,
+       spv::Op::OpHitObjectRecordFromQueryEXT,
+       spv::Op::OpHitObjectRecordMissEXT,
+       spv::Op::OpHitObjectRecordMissMotionEXT,
+       spv::Op::OpReorderThreadWithHintEXT,
+       spv::Op::OpReorderThreadWithHitObjectEXT,
+       spv::Op::OpHitObjectTraceRayEXT, spv::Op::OpHitObjectTraceRayMotionEXT,
+       spv::Op::OpHitObjectReorderExecuteShaderEXT,
+       spv::Op::OpHitObjectTraceReorderExecuteEXT,
+       spv::Op::OpHitObjectTraceMotionReorderExecuteEXT});
+  Add(MeshShadingPass,
+      {spv::Op::OpEmitMeshTasksEXT, spv::Op::OpSetMeshOutputsEXT,
+       spv::Op::OpWritePackedPrimitiveIndices4x8NV, spv::Op::OpVariable});
+  Add(TensorLayoutPass,
+      {spv::Op::OpCreateTensorLayoutNV, spv::Op::OpCreateTensorViewNV,
+       spv::Op::OpTensorLayoutSetBlockSizeNV,
+       spv::Op::OpTensorLayoutSetDimensionNV,
+       spv::Op::OpTensorLayoutSetStrideNV, spv::Op::OpTensorLayoutSliceNV,
+       spv::Op::OpTensorLayoutSetClampValueNV,
+       spv::Op::OpTensorViewSetDimensionNV, spv::Op::OpTensorViewSetStrideNV,
+       spv::Op::OpTensorViewSetClipNV});
+  Add(TensorPass,
+      {spv::Op::OpTensorReadARM, spv::Op::OpTensorWriteARM,
+       spv::Op::OpTensorQuerySizeARM});
+  Add(GraphPass,
+      {spv::Op::OpTypeGraphARM, spv::Op::OpGraphConstantARM,
+       spv::Op::OpGraphEntryPointARM, spv::Op::OpGraphARM,
+       spv::Op::OpGraphInputARM, spv::Op::OpGraphSetOutputARM,
+       spv::Op::OpGraphEndARM});
+  Add(InvalidTypePass,
+      {spv::Op::OpExtInst, spv::Op::OpFAdd, spv::Op::OpFSub, spv::Op::OpFMul,
+       spv::Op::OpFDiv, spv::Op::OpFRem, spv::Op::OpFMod, spv::Op::OpFNegate,
+       spv::Op::OpDPdx, spv::Op::OpDPdy, spv::Op::OpFwidth, spv::Op::OpDPdxFine,
+       spv::Op::OpDPdyFine, spv::Op::OpFwidthFine, spv::Op::OpDPdxCoarse,
+       spv::Op::OpDPdyCoarse, spv::Op::OpFwidthCoarse, spv::Op::OpAtomicFAddEXT,
+       spv::Op::OpAtomicFMinEXT, spv::Op::OpAtomicFMaxEXT,
+       spv::Op::OpAtomicLoad, spv::Op::OpAtomicExchange,
+       spv::Op::OpGroupNonUniformRotateKHR, spv::Op::OpGroupNonUniformBroadcast,
+       spv::Op::OpGroupNonUniformShuffle, spv::Op::OpGroupNonUniformShuffleXor,
+       spv::Op::OpGroupNonUniformShuffleUp,
+       spv::Op::OpGroupNonUniformShuffleDown,
+       spv::Op::OpGroupNonUniformQuadBroadcast,
+       spv::Op::OpGroupNonUniformQuadSwap,
+       spv::Op::OpGroupNonUniformBroadcastFirst, spv::Op::OpGroupNonUniformFAdd,
+       spv::Op::OpGroupNonUniformFMul, spv::Op::OpGroupNonUniformFMin,
+       spv::Op::OpAtomicStore, spv::Op::OpIsNan, spv::Op::OpIsInf,
+       spv::Op::OpIsFinite, spv::Op::OpIsNormal, spv::Op::OpSignBitSet,
+       spv::Op::OpGroupNonUniformAllEqual, spv::Op::OpMatrixTimesMatrix});
+
+  // Every opcode handled by the same set of passes shares one list.
+  std::unordered_map<uint32_t, uint8_t> list_of_mask;
+  list_index_.resize(kNumOpcodes);
+  for (uint32_t opcode = 0; opcode < kNumOpcodes; ++opcode) {
+    const uint32_t mask = masks_[opcode];
+    auto it = list_of_mask.find(mask);
+    if (it == list_of_mask.end()) {
+      assert(lists_.size() <= UINT8_MAX && "Too many distinct pass lists");
+      it = list_of_mask.emplace(mask, static_cast<uint8_t>(lists_.size()))
+               .first;
+      lists_.emplace_back();
+      for (size_t i = 0; i < passes_.size(); ++i) {
+        if (mask & (1u << i)) lists_.back().push_back(passes_[i]);
+      }
+    }
+    list_index_[opcode] = it->second;
+  }
+  masks_.clear();
+  masks_.shrink_to_fit();
+}
+
+void PassTable::Add(InstructionPass pass,
+                    std::initializer_list<spv::Op> opcodes,
+                    bool (*filter)(spv::Op)) {
+  assert(passes_.size() < 32 && "Too many passes for a 32-bit mask");
+  const uint32_t bit = 1u << passes_.size();
+  passes_.push_back(pass);
+  for (spv::Op opcode : opcodes) {
+    masks_[static_cast<uint32_t>(opcode)] |= bit;
+  }
+  if (filter) {
+    for (uint32_t opcode = 0; opcode < kNumOpcodes; ++opcode) {
+      if (filter(static_cast<spv::Op>(opcode))) masks_[opcode] |= bit;
+    }
+  }
+}
+
+}  // namespace
+
+const std::vector<InstructionPass>& InstructionPassesForOpcode(spv::Op opcode) {
+  static const PassTable table;
+  return table.passes(opcode);
+}
+
+}  // namespace val
+}  // namespace spvtools
@@ -352,7 +352,7 @@ spv_result_t ValidateTypeArray(ValidationState_t& _, const Instruction* inst) {
 
   int64_t length_value;
   if (_.EvalConstantValInt64(length_id, &length_value)) {
-    auto& type_words = const_result_type->words();
+    const auto type_words = const_result_type->words();
     const bool is_signed = type_words[3] > 0;
     if (length_value == 0 || (length_value < 0 && is_signed)) {
       return _.diag(SPV_ERROR_INVALID_ID, inst)
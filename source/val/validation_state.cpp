@@ -16,6 +16,7 @@
 
 #include "source/val/validation_state.h"
 
+#include <algorithm>
 #include <cassert>
 #include <stack>
 #include <utility>
@@ -133,10 +134,29 @@ spv_result_t CountInstructions(void* user_data,
     _.increment_total_functions();
   }
   _.increment_total_instructions();
+  _.increment_total_operands(inst->num_operands);
 
   return SPV_SUCCESS;
 }
 
+// Appends |count| elements starting at |first| to the last block in |blocks|
+// and returns where they were copied. A new block of at least |block_size|
+// elements is started when the last one is full. Blocks never grow past their
+// reserved capacity, so the returned pointers stay valid.
+template <typename T>
+const T* AppendToBlocks(std::vector<std::vector<T>>* blocks, const T* first,
+                        size_t count, size_t block_size) {
+  if (blocks->empty() ||
+      blocks->back().capacity() - blocks->back().size() < count) {
+    blocks->emplace_back();
+    blocks->back().reserve(std::max(count, block_size));
+  }
+  std::vector<T>& block = blocks->back();
+  const size_t offset = block.size();
+  block.insert(block.end(), first, first + count);
+  return block.data() + offset;
+}
+
 spv_result_t setHeader(void* user_data, spv_endianness_t, uint32_t,
                        uint32_t version, uint32_t generator, uint32_t id_bound,
                        uint32_t) {
@@ -195,6 +215,10 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
       max_num_of_warnings_(max_warnings) {
   assert(opt && "Validator options may not be Null.");
 
+  if (options_->num_threads > 1) {
+    thread_pool_ = MakeUnique<utils::ThreadPool>(options_->num_threads);
+  }
+
   const auto env = context_->target_env;
 
   if (spvIsVulkanEnv(env)) {
@@ -220,6 +244,7 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
   // Only attempt to count if we have words, otherwise let the other validation
   // fail and generate an error.
   if (num_words > 0) {
+    words_in_host_order_ = words[SPV_INDEX_MAGIC_NUMBER] == spv::MagicNumber;
     // Count the number of instructions in the binary.
     // This parse should not produce any error messages. Hijack the context and
     // replace the message consumer so that we do not pollute any state in input
@@ -245,6 +270,8 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
 void ValidationState_t::preallocateStorage() {
   ordered_instructions_.reserve(total_instructions_);
   module_functions_.reserve(total_functions_);
+  operand_blocks_.emplace_back();
+  operand_blocks_.back().reserve(total_operands_);
 }
 
 spv_result_t ValidationState_t::ForwardDeclareId(uint32_t id) {
@@ -562,7 +589,16 @@ void ValidationState_t::SetGraphDefinitionRegion(GraphDefinitionRegion region) {
 
 Instruction* ValidationState_t::AddOrderedInstruction(
     const spv_parsed_instruction_t* inst) {
-  ordered_instructions_.emplace_back(inst);
+  // Fallback block size for modules whose counting parse did not run.
+  const size_t kBlockSize = 4096;
+  spv_parsed_instruction_t stored = *inst;
+  if (!words_in_host_order_) {
+    stored.words = AppendToBlocks(&word_blocks_, inst->words,
+                                  inst->num_words, num_words_);
+  }
+  stored.operands = AppendToBlocks(&operand_blocks_, inst->operands,
+                                   inst->num_operands, kBlockSize);
+  ordered_instructions_.emplace_back(&stored);
   ordered_instructions_.back().SetLineNum(ordered_instructions_.size());
   return &ordered_instructions_.back();
 }
@@ -878,6 +914,16 @@ void ValidationState_t::RegisterStorageClassConsumer(
   }
 }
 
+std::vector<uint32_t> ValidationState_t::DecoratedIds() const {
+  std::vector<uint32_t> ids;
+  ids.reserve(decorations_.size());
+  for (uint32_t id = 0; id < decoration_slots_.size(); ++id) {
+    const uint32_t slot = decoration_slots_[id];
+    if (slot != 0 && !decorations_[slot - 1].empty()) ids.push_back(id);
+  }
+  return ids;
+}
+
 uint32_t ValidationState_t::getIdBound() const { return id_bound_; }
 
 void ValidationState_t::setIdBound(const uint32_t bound) { id_bound_ = bound; }
@@ -16,12 +16,15 @@
 #define SOURCE_VAL_VALIDATION_STATE_H_
 
 #include <algorithm>
+#include <deque>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "source/assembly_grammar.h"
@@ -33,6 +36,8 @@
 #include "source/spirv_definition.h"
 #include "source/spirv_validator_options.h"
 #include "source/table2.h"
+#include "source/util/hash_combine.h"
+#include "source/util/thread_pool.h"
 #include "source/val/decoration.h"
 #include "source/val/function.h"
 #include "source/val/instruction.h"
@@ -122,6 +127,8 @@ class ValidationState_t {
     bool env_allow_localsizeid = false;
   };
 
+  /// |words| must outlive this object unless the module is not in host
+  /// endianness, in which case the instruction words are copied.
   ValidationState_t(const spv_const_context context,
                     const spv_const_validator_options opt,
                     const uint32_t* words, const size_t num_words,
@@ -133,6 +140,24 @@ class ValidationState_t {
   /// Returns the command line options
   spv_const_validator_options options() const { return options_; }
 
+  /// Returns the pool used to check functions concurrently, or nullptr if the
+  /// options ask for a single thread. Work run on the pool must not emit
+  /// diagnostics or modify state shared between functions.
+  utils::ThreadPool* thread_pool() const { return thread_pool_.get(); }
+
+  /// Marks the functions in |ids| as unchanged since an earlier module that
+  /// passed validation. See FunctionCheckCache.
+  void set_unchanged_functions(std::unordered_set<uint32_t> ids) {
+    unchanged_functions_ = std::move(ids);
+  }
+
+  /// Returns true if the control flow and dominance checks can be skipped for
+  /// the function with the given id, because it is unchanged since an earlier
+  /// module that passed them.
+  bool IsUnchangedFunction(uint32_t id) const {
+    return unchanged_functions_.count(id) != 0;
+  }
+
   /// Sets the ID of the generator for this module.
   void setGenerator(uint32_t gen) { generator_ = gen; }
 
@@ -187,6 +212,9 @@ class ValidationState_t {
   /// Increments the total number of functions in the file.
   void increment_total_functions() { total_functions_++; }
 
+  /// Adds |count| to the total number of operands in the file.
+  void increment_total_operands(size_t count) { total_operands_ += count; }
+
   /// Allocates internal storage. Note, calling this will invalidate any
   /// pointers to |ordered_instructions_| or |module_functions_| and, hence,
   /// should only be called at the beginning of validation.
@@ -442,6 +470,9 @@ class ValidationState_t {
   const AssemblyGrammar& grammar() const { return grammar_; }
 
   /// Inserts the instruction into the list of ordered instructions in the file.
+  /// The new Instruction refers to the words of |inst| in the module binary
+  /// and to a copy of its operands in |operand_blocks_|, so the binary must
+  /// outlive this object.
   Instruction* AddOrderedInstruction(const spv_parsed_instruction_t* inst);
 
   /// Registers the instruction. This will add the instruction to the list of
@@ -453,15 +484,21 @@ class ValidationState_t {
 
   /// Registers the decoration for the given <id>
   void RegisterDecorationForId(uint32_t id, const Decoration& dec) {
-    auto& dec_list = id_decorations_[id];
-    dec_list.insert(dec);
+    if (dec.dec_type() == spv::Decoration::BuiltIn) {
+      builtin_decorated_ids_.insert(id);
+    }
+    id_decorations(id).insert(dec);
   }
 
   /// Registers the list of decorations for the given <id>
   template <class InputIt>
   void RegisterDecorationsForId(uint32_t id, InputIt begin, InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[id];
-    cur_decs.insert(begin, end);
+    for (InputIt iter = begin; iter != end; ++iter) {
+      if (iter->dec_type() == spv::Decoration::BuiltIn) {
+        builtin_decorated_ids_.insert(id);
+      }
+    }
+    id_decorations(id).insert(begin, end);
   }
 
   /// Registers the list of decorations for the given member of the given
@@ -470,19 +507,45 @@ class ValidationState_t {
   void RegisterDecorationsForStructMember(uint32_t struct_id,
                                           uint32_t member_index, InputIt begin,
                                           InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[struct_id];
+    std::set<Decoration>& cur_decs = id_decorations(struct_id);
     for (InputIt iter = begin; iter != end; ++iter) {
       Decoration dec = *iter;
+      if (dec.dec_type() == spv::Decoration::BuiltIn) {
+        builtin_decorated_ids_.insert(struct_id);
+      }
       dec.set_struct_member_index(member_index);
       cur_decs.insert(dec);
     }
   }
 
   /// Returns all the decorations for the given <id>. If no decorations exist
-  /// for the <id>, it registers an empty set for it in the map and
-  /// returns the empty set.
+  /// for the <id>, it registers an empty set for it and returns the empty set.
   std::set<Decoration>& id_decorations(uint32_t id) {
-    return id_decorations_[id];
+    if (id >= decoration_slots_.size()) decoration_slots_.resize(id + 1, 0);
+    uint32_t& slot = decoration_slots_[id];
+    if (slot == 0) {
+      decorations_.emplace_back();
+      slot = static_cast<uint32_t>(decorations_.size());
+    }
+    return decorations_[slot - 1];
+  }
+
+  /// Returns the decorations for the given <id>, or nullptr if none have been
+  /// registered.
+  const std::set<Decoration>* FindDecorations(uint32_t id) const {
+    if (id >= decoration_slots_.size() || decoration_slots_[id] == 0) {
+      return nullptr;
+    }
+    return &decorations_[decoration_slots_[id] - 1];
+  }
+
+  /// Returns the ids that have at least one decoration, in increasing order.
+  std::vector<uint32_t> DecoratedIds() const;
+
+  /// Returns the ids with a BuiltIn decoration on themselves or on one of
+  /// their members, in increasing order.
+  const std::set<uint32_t>& builtin_decorated_ids() const {
+    return builtin_decorated_ids_;
   }
 
   /// Returns the range of decorations for the given field of the given <id>.
@@ -492,7 +555,7 @@ class ValidationState_t {
   };
   FieldDecorationsIter id_member_decorations(uint32_t id,
                                              uint32_t member_index) {
-    const auto& decorations = id_decorations_[id];
+    const auto& decorations = id_decorations(id);
 
     // The decorations are sorted by member_index, so this look up will give the
     // exact range of decorations for this member index.
@@ -506,19 +569,14 @@ class ValidationState_t {
     return result;
   }
 
-  // Returns const pointer to the internal decoration container.
-  const std::map<uint32_t, std::set<Decoration>>& id_decorations() const {
-    return id_decorations_;
-  }
-
   /// Returns true if the given id <id> has the given decoration <dec>,
   /// otherwise returns false.
   bool HasDecoration(uint32_t id, spv::Decoration dec) {
-    const auto& decorations = id_decorations_.find(id);
-    if (decorations == id_decorations_.end()) return false;
+    const auto* decorations = FindDecorations(id);
+    if (!decorations) return false;
 
     return std::any_of(
-        decorations->second.begin(), decorations->second.end(),
+        decorations->begin(), decorations->end(),
         [dec](const Decoration& d) { return dec == d.dec_type(); });
   }
 
@@ -978,6 +1036,22 @@ class ValidationState_t {
   size_t total_instructions_ = 0;
   /// The total number of functions in the binary.
   size_t total_functions_ = 0;
+  /// The total number of operands in the binary.
+  size_t total_operands_ = 0;
+
+  /// True if the module is in host endianness, so the parser hands out
+  /// instruction words that point into |words_|.
+  bool words_in_host_order_ = false;
+
+  /// Flat storage for the operands of |ordered_instructions_|. The first block
+  /// is sized by the counting parse, so it normally holds every operand. More
+  /// blocks are only added if that count is exceeded, which keeps pointers
+  /// into earlier blocks valid.
+  std::vector<std::vector<spv_parsed_operand_t>> operand_blocks_;
+
+  /// Copies of instruction words, only used when the module is not in host
+  /// endianness and the parser's words are converted into a scratch buffer.
+  std::vector<std::vector<uint32_t>> word_blocks_;
 
   /// IDs which have been forward declared but have not been defined
   std::unordered_set<uint32_t> unresolved_forward_ids_;
@@ -1053,14 +1127,26 @@ class ValidationState_t {
   std::unordered_map<uint32_t, bool>
       struct_has_nested_blockorbufferblock_struct_;
 
-  /// Stores the list of decorations for a given <id>
-  std::map<uint32_t, std::set<Decoration>> id_decorations_;
+  /// Stores the list of decorations for a given <id>. |decoration_slots_| is
+  /// indexed by id and holds one plus the index of the id's decorations in
+  /// |decorations_|, or 0 if the id has none. A deque keeps references to the
+  /// sets valid as more ids are decorated.
+  std::vector<uint32_t> decoration_slots_;
+  std::deque<std::set<Decoration>> decorations_;
+
+  /// The ids with a BuiltIn decoration, gathered as decorations are
+  /// registered.
+  std::set<uint32_t> builtin_decorated_ids_;
 
   /// Stores type declarations which need to be unique (i.e. non-aggregates),
   /// in the form [opcode, operand words], result_id is not stored.
-  /// Using ordered set to avoid the need for a vector hash function.
-  /// The size of this container is expected not to exceed double-digits.
-  std::set<std::vector<uint32_t>> unique_type_declarations_;
+  struct WordsHash {
+    size_t operator()(const std::vector<uint32_t>& words) const {
+      return utils::hash_combine(0, words);
+    }
+  };
+  std::unordered_set<std::vector<uint32_t>, WordsHash>
+      unique_type_declarations_;
 
   AssemblyGrammar grammar_;
 
@@ -1137,6 +1223,12 @@ class ValidationState_t {
   /// Variables used to reduce the number of diagnostic messages.
   uint32_t num_of_warnings_;
   uint32_t max_num_of_warnings_;
+
+  /// The pool used to check functions concurrently, if any.
+  std::unique_ptr<utils::ThreadPool> thread_pool_;
+
+  /// The functions whose control flow and dominance checks are skipped.
+  std::unordered_set<uint32_t> unchanged_functions_;
 };
 
 }  // namespace val
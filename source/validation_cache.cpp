@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "source/spirv_validator_options.h"
+#include "spirv-tools/libspirv.hpp"
+
+namespace spvtools {
+namespace {
+
+// Two independent 64-bit lanes of a multiply-xorshift hash. Together they
+// make collisions between distinct modules vanishingly unlikely, while
+// hashing a word costs a couple of multiplications.
+class Digest {
+ public:
+  void Add(uint64_t value) {
+    lo_ = Mix(lo_ ^ value, 0x9e3779b97f4a7c15ull);
+    hi_ = Mix(hi_ + value, 0xc2b2ae3d27d4eb4full);
+  }
+
+  void Add(const std::string& text) {
+    Add(text.size());
+    for (const char c : text) Add(static_cast<unsigned char>(c));
+  }
+
+  // Returns the digest as 32 hexadecimal digits.
+  std::string Hex() const {
+    char buffer[33];
+    snprintf(buffer, sizeof(buffer), "%016llx%016llx",
+             static_cast<unsigned long long>(hi_),
+             static_cast<unsigned long long>(lo_));
+    return buffer;
+  }
+
+ private:
+  static uint64_t Mix(uint64_t value, uint64_t multiplier) {
+    value *= multiplier;
+    return value ^ (value >> 29);
+  }
+
+  uint64_t lo_ = 0x243f6a8885a308d3ull;
+  uint64_t hi_ = 0x13198a2e03707344ull;
+};
+
+}  // namespace
+
+ValidationCache::~ValidationCache() = default;
+
+std::string ValidationCache::Key(spv_target_env env,
+                                 spv_validator_options options,
+                                 const uint32_t* binary, size_t binary_size) {
+  const spv_validator_options_t default_options;
+  const spv_validator_options_t& o = options ? *options : default_options;
+
+  Digest digest;
+  digest.Add(std::string(spvSoftwareVersionDetailsString()));
+  digest.Add(static_cast<uint64_t>(env));
+  const validator_universal_limits_t& limits = o.universal_limits_;
+  for (const uint32_t limit :
+       {limits.max_struct_members, limits.max_struct_depth,
+        limits.max_local_variables, limits.max_global_variables,
+        limits.max_switch_branches, limits.max_function_args,
+        limits.max_control_flow_nesting_depth,
+        limits.max_access_chain_indexes, limits.max_id_bound}) {
+    digest.Add(limit);
+  }
+  // The friendly names and the number of threads only change how
+  // diagnostics are produced, and the function check cache is internal.
+  uint64_t flags = 0;
+  for (const bool flag :
+       {o.relax_struct_store, o.relax_logical_pointer, o.relax_block_layout,
+        o.uniform_buffer_standard_layout, o.scalar_block_layout,
+        o.workgroup_scalar_block_layout, o.skip_block_layout,
+        o.allow_localsizeid, o.allow_offset_texture_operand,
+        o.allow_vulkan_32_bit_bitwise, o.before_hlsl_legalization}) {
+    flags = (flags << 1) | (flag ? 1 : 0);
+  }
+  digest.Add(flags);
+
+  digest.Add(binary_size);
+  for (size_t i = 0; i < binary_size; ++i) digest.Add(binary[i]);
+  return digest.Hex();
+}
+
+struct InMemoryValidationCache::Impl {
+  explicit Impl(size_t c) : capacity(c) {}
+
+  const size_t capacity;
+  std::mutex mutex;
+  // The keys, most recently used first.
+  std::list<std::string> keys;
+  std::unordered_map<std::string, std::list<std::string>::iterator> positions;
+};
+
+InMemoryValidationCache::InMemoryValidationCache(size_t capacity)
+    : impl_(new Impl(capacity)) {}
+
+InMemoryValidationCache::~InMemoryValidationCache() = default;
+
+bool InMemoryValidationCache::Contains(const std::string& key) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  const auto where = impl_->positions.find(key);
+  if (where == impl_->positions.end()) return false;
+  impl_->keys.splice(impl_->keys.begin(), impl_->keys, where->second);
+  return true;
+}
+
+void InMemoryValidationCache::Insert(const std::string& key) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  if (impl_->capacity == 0) return;
+  const auto where = impl_->positions.find(key);
+  if (where != impl_->positions.end()) {
+    impl_->keys.splice(impl_->keys.begin(), impl_->keys, where->second);
+    return;
+  }
+  if (impl_->keys.size() == impl_->capacity) {
+    impl_->positions.erase(impl_->keys.back());
+    impl_->keys.pop_back();
+  }
+  impl_->keys.push_front(key);
+  impl_->positions.emplace(key, impl_->keys.begin());
+}
+
+DirectoryValidationCache::DirectoryValidationCache(std::string directory)
+    : directory_(std::move(directory)) {}
+
+bool DirectoryValidationCache::Contains(const std::string& key) {
+  // An entry only counts if it holds its own key. A truncated or otherwise
+  // damaged file is treated as a miss, and Insert() rewrites it once the
+  // module has been validated again.
+  std::ifstream entry(directory_ + "/" + key);
+  std::string contents;
+  return std::getline(entry, contents) && contents == key;
+}
+
+void DirectoryValidationCache::Insert(const std::string& key) {
+  // Failures to write are ignored: the module is then simply validated again
+  // next time.
+  std::ofstream entry(directory_ + "/" + key, std::ios::trunc);
+  entry << key << "\n";
+}
+
+}  // namespace spvtools
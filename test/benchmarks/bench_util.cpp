@@ -0,0 +1,329 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/benchmarks/bench_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <sys/resource.h>
+#define SPIRV_BENCH_HAS_GETRUSAGE 1
+#endif
+
+#include "source/spirv_constant.h"
+#include "spirv-tools/libspirv.hpp"
+
+#ifndef SPIRV_BENCH_CORPUS_DIR
+#define SPIRV_BENCH_CORPUS_DIR ""
+#endif
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Reads the SPIR-V binary in |path| into |binary|. Returns false if the file
+// cannot be read or does not hold a whole number of words.
+bool ReadBinary(const std::filesystem::path& path, Binary* binary) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+  std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+  if (bytes.empty() || bytes.size() % sizeof(uint32_t) != 0) return false;
+  binary->resize(bytes.size() / sizeof(uint32_t));
+  std::copy(bytes.begin(), bytes.end(),
+            reinterpret_cast<char*>(binary->data()));
+  return true;
+}
+
+std::vector<Binary> LoadCorpus() {
+  const char* dir = std::getenv("SPIRV_BENCH_CORPUS_DIR");
+  if (dir == nullptr || *dir == '\0') dir = SPIRV_BENCH_CORPUS_DIR;
+
+  std::vector<std::filesystem::path> paths;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    if (entry.is_regular_file()) paths.push_back(entry.path());
+  }
+  if (ec) {
+    fprintf(stderr, "warning: cannot read benchmark corpus '%s'\n", dir);
+  }
+  // Sort so that runs are comparable regardless of directory order.
+  std::sort(paths.begin(), paths.end());
+
+  SpirvTools tools(kBenchEnv);
+  tools.SetMessageConsumer([](spv_message_level_t, const char*,
+                              const spv_position_t&, const char*) {});
+  std::vector<Binary> modules;
+  for (const auto& path : paths) {
+    Binary binary;
+    if (ReadBinary(path, &binary) && tools.Validate(binary)) {
+      modules.push_back(std::move(binary));
+    }
+  }
+  return modules;
+}
+
+}  // namespace
+
+const std::vector<Binary>& CorpusModules() {
+  static const std::vector<Binary> modules = LoadCorpus();
+  return modules;
+}
+
+size_t CountWords(const std::vector<Binary>& modules) {
+  size_t words = 0;
+  for (const auto& module : modules) words += module.size();
+  return words;
+}
+
+size_t CountInstructions(const std::vector<Binary>& modules) {
+  size_t instructions = 0;
+  for (const auto& module : modules) {
+    // Skip the header, then step over each instruction by its word count.
+    size_t index = SPV_INDEX_INSTRUCTION;
+    while (index < module.size()) {
+      const uint32_t word_count = module[index] >> 16;
+      if (word_count == 0) break;
+      index += word_count;
+      ++instructions;
+    }
+  }
+  return instructions;
+}
+
+std::string MakeSyntheticModuleText(uint32_t num_functions,
+                                    const std::string& export_prefix) {
+  const bool is_library = !export_prefix.empty();
+  std::string text;
+  text += "OpCapability Shader\n";
+  if (is_library) text += "OpCapability Linkage\n";
+  text += "OpMemoryModel Logical GLSL450\n";
+  if (!is_library) {
+    text += "OpEntryPoint GLCompute %main \"main\"\n";
+    text += "OpExecutionMode %main LocalSize 1 1 1\n";
+  } else {
+    for (uint32_t i = 0; i < num_functions; ++i) {
+      const std::string f = "%f" + std::to_string(i);
+      text += "OpDecorate " + f + " LinkageAttributes \"" + export_prefix +
+              "f" + std::to_string(i) + "\" Export\n";
+    }
+  }
+  text += R"(%void = OpTypeVoid
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%ptr_int = OpTypePointer Function %int
+%int_0 = OpConstant %int 0
+%int_1 = OpConstant %int 1
+%int_3 = OpConstant %int 3
+%int_16 = OpConstant %int 16
+%fn_void = OpTypeFunction %void
+%fn_int_int = OpTypeFunction %int %int
+)";
+
+  for (uint32_t i = 0; i < num_functions; ++i) {
+    const std::string f = "%f" + std::to_string(i);
+    std::string body = R"($ = OpFunction %int None %fn_int_int
+$_a = OpFunctionParameter %int
+$_entry = OpLabel
+$_var = OpVariable %ptr_int Function
+OpStore $_var $_a
+OpBranch $_header
+$_header = OpLabel
+$_i = OpPhi %int %int_0 $_entry $_inext $_continue
+$_cond = OpSLessThan %bool $_i %int_16
+OpLoopMerge $_merge $_continue None
+OpBranchConditional $_cond $_body $_merge
+$_body = OpLabel
+$_x = OpLoad %int $_var
+$_odd = OpBitwiseAnd %int $_i %int_1
+$_is_odd = OpIEqual %bool $_odd %int_1
+OpSelectionMerge $_join None
+OpBranchConditional $_is_odd $_then $_join
+$_then = OpLabel
+$_y = OpIMul %int $_x %int_3
+$_z = OpIAdd %int $_y $_i
+OpStore $_var $_z
+OpBranch $_join
+$_join = OpLabel
+OpBranch $_continue
+$_continue = OpLabel
+$_inext = OpIAdd %int $_i %int_1
+OpBranch $_header
+$_merge = OpLabel
+$_r = OpLoad %int $_var
+OpReturnValue $_r
+OpFunctionEnd
+)";
+    // '$' stands for the name of the function being generated.
+    for (size_t pos = body.find('$'); pos != std::string::npos;
+         pos = body.find('$', pos + f.size())) {
+      body.replace(pos, 1, f);
+    }
+    text += body;
+  }
+
+  if (!is_library) {
+    text += "%main = OpFunction %void None %fn_void\n";
+    text += "%main_entry = OpLabel\n";
+    for (uint32_t i = 0; i < num_functions; ++i) {
+      text += "%call" + std::to_string(i) + " = OpFunctionCall %int %f" +
+              std::to_string(i) + " %int_1\n";
+    }
+    text += "OpReturn\nOpFunctionEnd\n";
+  }
+  return text;
+}
+
+Binary MakeSyntheticModule(uint32_t num_functions,
+                           const std::string& export_prefix) {
+  SpirvTools tools(kBenchEnv);
+  Binary binary;
+  if (!tools.Assemble(MakeSyntheticModuleText(num_functions, export_prefix),
+                      &binary)) {
+    fprintf(stderr, "error: cannot assemble the synthetic module\n");
+    std::abort();
+  }
+  return binary;
+}
+
+Binary MakeSelectionChainModule(uint32_t num_selections) {
+  std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+%void = OpTypeVoid
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%true = OpConstantTrue %bool
+%int_1 = OpConstant %int 1
+%fn_void = OpTypeFunction %void
+%main = OpFunction %void None %fn_void
+%entry = OpLabel
+%x = OpIAdd %int %int_1 %int_1
+)";
+  for (uint32_t i = 0; i < num_selections; ++i) {
+    const std::string n = std::to_string(i);
+    text += "OpSelectionMerge %merge" + n + " None\n";
+    text += "OpBranchConditional %true %then" + n + " %merge" + n + "\n";
+    text += "%then" + n + " = OpLabel\n";
+    text += "OpBranch %merge" + n + "\n";
+    text += "%merge" + n + " = OpLabel\n";
+    text += "%y" + n + " = OpIAdd %int %x %int_1\n";
+  }
+  text += "OpReturn\nOpFunctionEnd\n";
+
+  SpirvTools tools(kBenchEnv);
+  Binary binary;
+  if (!tools.Assemble(text, &binary)) {
+    fprintf(stderr, "error: cannot assemble the selection chain module\n");
+    std::abort();
+  }
+  return binary;
+}
+
+Binary MakeDecoratedBlocksModule(uint32_t num_blocks) {
+  constexpr uint32_t kNumMembers = 8;
+  std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+)";
+  for (uint32_t i = 0; i < num_blocks; ++i) {
+    const std::string n = std::to_string(i);
+    text += "OpDecorate %block" + n + " Block\n";
+    for (uint32_t m = 0; m < kNumMembers; ++m) {
+      text += "OpMemberDecorate %block" + n + " " + std::to_string(m) +
+              " Offset " + std::to_string(4 * m) + "\n";
+    }
+    text += "OpDecorate %var" + n + " DescriptorSet 0\n";
+    text += "OpDecorate %var" + n + " Binding " + n + "\n";
+  }
+  text += R"(%void = OpTypeVoid
+%float = OpTypeFloat 32
+%fn_void = OpTypeFunction %void
+)";
+  for (uint32_t i = 0; i < num_blocks; ++i) {
+    const std::string n = std::to_string(i);
+    text += "%block" + n + " = OpTypeStruct";
+    for (uint32_t m = 0; m < kNumMembers; ++m) text += " %float";
+    text += "\n";
+    text += "%ptr" + n + " = OpTypePointer Uniform %block" + n + "\n";
+    text += "%var" + n + " = OpVariable %ptr" + n + " Uniform\n";
+  }
+  text += R"(%main = OpFunction %void None %fn_void
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  SpirvTools tools(kBenchEnv);
+  Binary binary;
+  if (!tools.Assemble(text, &binary)) {
+    fprintf(stderr, "error: cannot assemble the decorated blocks module\n");
+    std::abort();
+  }
+  return binary;
+}
+
+const std::vector<Binary>& InputModules(int64_t num_functions) {
+  if (num_functions == 0) return CorpusModules();
+  static std::map<int64_t, std::vector<Binary>> synthetic;
+  auto& modules = synthetic[num_functions];
+  if (modules.empty()) {
+    modules.push_back(
+        MakeSyntheticModule(static_cast<uint32_t>(num_functions)));
+  }
+  return modules;
+}
+
+void InputArgs(benchmark::internal::Benchmark* b) {
+  b->ArgName("functions")->Arg(0)->Arg(100)->Arg(1000)->Arg(10000);
+  b->Unit(benchmark::kMillisecond);
+}
+
+size_t PeakRssKilobytes() {
+#if defined(SPIRV_BENCH_HAS_GETRUSAGE)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  // macOS reports ru_maxrss in bytes rather than kilobytes.
+  return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#else
+  return 0;
+#endif
+}
+
+void ReportCounters(benchmark::State& state, size_t words_per_iteration) {
+  const double words = static_cast<double>(words_per_iteration) *
+                       static_cast<double>(state.iterations());
+  state.counters["words/s"] =
+      benchmark::Counter(words, benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(static_cast<int64_t>(
+      words_per_iteration * sizeof(uint32_t) *
+      static_cast<size_t>(state.iterations())));
+  state.counters["peak_rss_kb"] =
+      benchmark::Counter(static_cast<double>(PeakRssKilobytes()));
+}
+
+}  // namespace bench
+}  // namespace spvtools
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_BENCHMARKS_BENCH_UTIL_H_
+#define TEST_BENCHMARKS_BENCH_UTIL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "spirv-tools/libspirv.h"
+
+namespace spvtools {
+namespace bench {
+
+// The target environment used by every benchmark in the suite.
+constexpr spv_target_env kBenchEnv = SPV_ENV_UNIVERSAL_1_6;
+
+using Binary = std::vector<uint32_t>;
+
+// Returns the modules of the benchmark corpus that parse and validate under
+// |kBenchEnv|. The corpus is read once from the directory named by the
+// SPIRV_BENCH_CORPUS_DIR environment variable, or from the directory the
+// benchmark was configured with (test/fuzzers/corpora/spv) if it is unset.
+const std::vector<Binary>& CorpusModules();
+
+// Returns the total number of words in |modules|.
+size_t CountWords(const std::vector<Binary>& modules);
+
+// Returns the total number of instructions in |modules|.
+size_t CountInstructions(const std::vector<Binary>& modules);
+
+// Returns the assembly of a synthetic, valid shader module with
+// |num_functions| functions. Every function contains a counted loop with
+// loads, stores, a selection and arithmetic on a function-scope variable.
+// If |export_prefix| is empty, the module has a GLCompute entry point that
+// calls every function. Otherwise the module is a library that exports each
+// function under the name "<export_prefix>f<index>", so that modules generated
+// with distinct prefixes can be linked together.
+std::string MakeSyntheticModuleText(uint32_t num_functions,
+                                    const std::string& export_prefix = "");
+
+// Like MakeSyntheticModuleText, but returns the assembled binary.
+Binary MakeSyntheticModule(uint32_t num_functions,
+                           const std::string& export_prefix = "");
+
+// Returns a valid shader module whose only function is a sequence of
+// |num_selections| selections, each with a then-block and a merge block. The
+// dominator tree of the function is about 2 * |num_selections| blocks deep,
+// and a value defined in the entry block is used in every merge block.
+Binary MakeSelectionChainModule(uint32_t num_selections);
+
+// Returns a valid shader module with |num_blocks| uniform blocks that are not
+// used by its entry point. Each block is a struct with eight float members,
+// and carries a Block decoration, an Offset decoration on every member, and
+// DescriptorSet and Binding decorations on its variable.
+Binary MakeDecoratedBlocksModule(uint32_t num_blocks);
+
+// Returns the modules a benchmark run with argument |num_functions| should
+// process: the corpus if |num_functions| is 0, otherwise a single synthetic
+// module with that many functions. Synthetic modules are built once per size.
+const std::vector<Binary>& InputModules(int64_t num_functions);
+
+// Registers the standard arguments of a benchmark that reads its input from
+// InputModules(): the corpus, then synthetic modules of increasing size.
+void InputArgs(benchmark::internal::Benchmark* b);
+
+// Returns the peak resident set size of the process in kilobytes, or 0 if it
+// cannot be measured on this platform.
+size_t PeakRssKilobytes();
+
+// Reports the throughput of |state| as words and bytes per second, given that
+// every iteration processed |words_per_iteration| words, and the peak
+// resident set size of the process.
+void ReportCounters(benchmark::State& state, size_t words_per_iteration);
+
+}  // namespace bench
+}  // namespace spvtools
+
+#endif  // TEST_BENCHMARKS_BENCH_UTIL_H_
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the binary parser, the assembler and the disassembler.
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "spirv-tools/libspirv.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+spv_result_t CountInstruction(void* user_data,
+                              const spv_parsed_instruction_t*) {
+  ++*static_cast<size_t*>(user_data);
+  return SPV_SUCCESS;
+}
+
+void BM_Parse(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  spv_context context = spvContextCreate(kBenchEnv);
+  for (auto _ : state) {
+    size_t num_instructions = 0;
+    for (const auto& binary : modules) {
+      spvBinaryParse(context, &num_instructions, binary.data(), binary.size(),
+                     nullptr, CountInstruction, nullptr);
+    }
+    benchmark::DoNotOptimize(num_instructions);
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_Parse)->Apply(InputArgs);
+
+void BM_Assemble(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  spv_context context = spvContextCreate(kBenchEnv);
+  std::vector<std::string> texts;
+  for (const auto& binary : modules) {
+    spv_text text = nullptr;
+    if (spvBinaryToText(context, binary.data(), binary.size(),
+                        SPV_BINARY_TO_TEXT_OPTION_NONE, &text,
+                        nullptr) == SPV_SUCCESS) {
+      texts.emplace_back(text->str, text->length);
+    }
+    spvTextDestroy(text);
+  }
+  for (auto _ : state) {
+    for (const auto& text : texts) {
+      spv_binary binary = nullptr;
+      spvTextToBinary(context, text.data(), text.size(), &binary, nullptr);
+      benchmark::DoNotOptimize(binary);
+      spvBinaryDestroy(binary);
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_Assemble)->Apply(InputArgs);
+
+void BM_Disassemble(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  spv_context context = spvContextCreate(kBenchEnv);
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      spv_text text = nullptr;
+      spvBinaryToText(context, binary.data(), binary.size(),
+                      SPV_BINARY_TO_TEXT_OPTION_NONE, &text, nullptr);
+      benchmark::DoNotOptimize(text);
+      spvTextDestroy(text);
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_Disassemble)->Apply(InputArgs);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
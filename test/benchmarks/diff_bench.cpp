@@ -0,0 +1,66 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the semantic diff of two modules.
+
+#include <sstream>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "source/diff/diff.h"
+#include "source/opt/build_module.h"
+#include "spirv-tools/optimizer.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Diffs every input module against its size-optimized version. Building the
+// two IRContexts is part of the measurement, as it is for spirv-diff.
+void BM_Diff(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  const MessageConsumer consumer = [](spv_message_level_t, const char*,
+                                      const spv_position_t&, const char*) {};
+  std::vector<Binary> optimized(modules.size());
+  for (size_t i = 0; i < modules.size(); ++i) {
+    // A pass can only run once, so every module needs a new optimizer.
+    Optimizer optimizer(kBenchEnv);
+    optimizer.SetMessageConsumer(consumer);
+    optimizer.RegisterSizePasses();
+    if (!optimizer.Run(modules[i].data(), modules[i].size(), &optimized[i])) {
+      state.SkipWithError("the optimizer failed on an input module");
+      return;
+    }
+  }
+
+  diff::Options options;
+  for (auto _ : state) {
+    for (size_t i = 0; i < modules.size(); ++i) {
+      auto src = BuildModule(kBenchEnv, consumer, modules[i].data(),
+                             modules[i].size());
+      auto dst = BuildModule(kBenchEnv, consumer, optimized[i].data(),
+                             optimized[i].size());
+      std::ostringstream out;
+      diff::Diff(src.get(), dst.get(), out, options);
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  ReportCounters(state, CountWords(modules) + CountWords(optimized));
+}
+BENCHMARK(BM_Diff)->Apply(InputArgs);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
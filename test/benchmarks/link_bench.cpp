@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the linker.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Functions in each of the linked library modules.
+constexpr uint32_t kFunctionsPerLibrary = 16;
+
+// Array sizes declared by the library linked in BM_LinkCopies. Each size adds
+// a constant and three types.
+constexpr uint32_t kTypeGroupsPerLibrary = 64;
+
+// Returns a library that only declares types: for every array size, an array
+// of floats, a struct wrapping it, and a pointer to that struct.
+Binary MakeTypeLibrary() {
+  std::string text = R"(
+               OpCapability Shader
+               OpCapability Linkage
+               OpMemoryModel Logical GLSL450
+       %uint = OpTypeInt 32 0
+      %float = OpTypeFloat 32
+)";
+  for (uint32_t i = 0; i < kTypeGroupsPerLibrary; ++i) {
+    const std::string n = std::to_string(i);
+    text += "%size" + n + " = OpConstant %uint " + std::to_string(i + 1);
+    text += "\n";
+    text += "%array" + n + " = OpTypeArray %float %size" + n + "\n";
+    text += "%struct" + n + " = OpTypeStruct %array" + n + " %uint\n";
+    text += "%ptr" + n + " = OpTypePointer Function %struct" + n + "\n";
+  }
+  SpirvTools tools(kBenchEnv);
+  Binary binary;
+  if (!tools.Assemble(text, &binary)) {
+    fprintf(stderr, "error: cannot assemble the type library\n");
+    std::abort();
+  }
+  return binary;
+}
+
+// Links state.range(0) library modules that declare the same types and
+// constants but export distinct functions, so the linker has to merge the
+// module-level declarations of every input.
+void BM_Link(benchmark::State& state) {
+  std::vector<Binary> libraries;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    libraries.push_back(MakeSyntheticModule(
+        kFunctionsPerLibrary, "lib" + std::to_string(i) + "_"));
+  }
+  Context context(kBenchEnv);
+  context.SetMessageConsumer([](spv_message_level_t, const char*,
+                                const spv_position_t&, const char*) {});
+  LinkerOptions options;
+  options.SetCreateLibrary(true);
+  for (auto _ : state) {
+    std::vector<uint32_t> linked;
+    Link(context, libraries, &linked, options);
+    benchmark::DoNotOptimize(linked.data());
+  }
+  ReportCounters(state, CountWords(libraries));
+}
+BENCHMARK(BM_Link)
+    ->ArgName("modules")
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+// Links state.range(0) copies of one library that declares nothing but
+// types, so the time is dominated by removing the duplicate types.
+void BM_LinkCopies(benchmark::State& state) {
+  const std::vector<Binary> libraries(static_cast<size_t>(state.range(0)),
+                                      MakeTypeLibrary());
+  Context context(kBenchEnv);
+  context.SetMessageConsumer([](spv_message_level_t, const char*,
+                                const spv_position_t&, const char*) {});
+  LinkerOptions options;
+  options.SetCreateLibrary(true);
+  for (auto _ : state) {
+    std::vector<uint32_t> linked;
+    Link(context, libraries, &linked, options);
+    benchmark::DoNotOptimize(linked.data());
+  }
+  ReportCounters(state, CountWords(libraries));
+}
+BENCHMARK(BM_LinkCopies)
+    ->ArgName("copies")
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the optimization recipes of the optimizer, and for building
+// and destroying the IR they work on.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "source/opt/build_module.h"
+#include "source/opt/ir_context.h"
+#include "source/opt/pass_manager.h"
+#include "source/opt/passes.h"
+#include "spirv-tools/optimizer.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+const MessageConsumer kIgnoreMessages = [](spv_message_level_t, const char*,
+                                            const spv_position_t&,
+                                            const char*) {};
+
+// Loads every input module into an IRContext. Compare builds with and without
+// SPIRV_OPT_USE_ARENA and SPIRV_TOOLS_USE_MIMALLOC to see how allocation
+// affects loading.
+void BM_BuildModule(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      auto context =
+          BuildModule(kBenchEnv, kIgnoreMessages, binary.data(), binary.size());
+      benchmark::DoNotOptimize(context.get());
+      state.PauseTiming();
+      context.reset();
+      state.ResumeTiming();
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_BuildModule)->Apply(InputArgs);
+
+// Destroys an IRContext holding each input module, with its def-use analysis
+// built as most passes would leave it.
+void BM_DestroyContext(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      state.PauseTiming();
+      auto context =
+          BuildModule(kBenchEnv, kIgnoreMessages, binary.data(), binary.size());
+      context->get_def_use_mgr();
+      state.ResumeTiming();
+      context.reset();
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_DestroyContext)->Apply(InputArgs);
+
+// Serializes an IRContext holding each input module, as Optimizer::Run does
+// after the last pass.
+void BM_ModuleToBinary(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  std::vector<std::unique_ptr<opt::IRContext>> contexts;
+  for (const auto& binary : modules) {
+    contexts.push_back(
+        BuildModule(kBenchEnv, kIgnoreMessages, binary.data(), binary.size()));
+  }
+  for (auto _ : state) {
+    for (const auto& context : contexts) {
+      std::vector<uint32_t> binary;
+      context->module()->ToBinary(&binary, /* skip_nop = */ true);
+      benchmark::DoNotOptimize(binary.data());
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_ModuleToBinary)->Apply(InputArgs);
+
+enum class Recipe { kPerformance, kSize, kLegalization };
+
+// Returns an optimizer with the passes of |recipe|. A pass can only run once,
+// so every run needs a new optimizer.
+std::unique_ptr<Optimizer> MakeOptimizer(Recipe recipe) {
+  auto optimizer = std::make_unique<Optimizer>(kBenchEnv);
+  optimizer->SetMessageConsumer(kIgnoreMessages);
+  switch (recipe) {
+    case Recipe::kPerformance:
+      optimizer->RegisterPerformancePasses();
+      break;
+    case Recipe::kSize:
+      optimizer->RegisterSizePasses();
+      break;
+    case Recipe::kLegalization:
+      optimizer->RegisterLegalizationPasses();
+      break;
+  }
+  return optimizer;
+}
+
+// Runs |recipe| on every input module. Creating and destroying the optimizer
+// is not measured.
+void BM_Optimize(benchmark::State& state, Recipe recipe) {
+  const auto& modules = InputModules(state.range(0));
+  bool failed = false;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      state.PauseTiming();
+      auto optimizer = MakeOptimizer(recipe);
+      state.ResumeTiming();
+      std::vector<uint32_t> optimized;
+      failed = !optimizer->Run(binary.data(), binary.size(), &optimized);
+      benchmark::DoNotOptimize(optimized.data());
+      state.PauseTiming();
+      optimizer.reset();
+      state.ResumeTiming();
+      if (failed) break;
+    }
+    if (failed) {
+      state.SkipWithError("the optimizer failed on an input module");
+      break;
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK_CAPTURE(BM_Optimize, performance, Recipe::kPerformance)
+    ->Apply(InputArgs);
+BENCHMARK_CAPTURE(BM_Optimize, size, Recipe::kSize)->Apply(InputArgs);
+BENCHMARK_CAPTURE(BM_Optimize, legalization, Recipe::kLegalization)
+    ->Apply(InputArgs);
+
+// Loads, optimizes and destroys large synthetic modules with passes that
+// create and free many instructions and blocks, to compare builds with and
+// without SPIRV_OPT_USE_ARENA. Reports the time of each phase and the memory
+// reserved by the arena. Run it alone so that peak_rss_kb is its own.
+void BM_LoadOptimizeDestroy(benchmark::State& state) {
+  using Clock = std::chrono::steady_clock;
+  const auto& modules = InputModules(state.range(0));
+  double load_seconds = 0;
+  double optimize_seconds = 0;
+  double destroy_seconds = 0;
+  size_t arena_bytes = 0;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      const auto start = Clock::now();
+      auto context =
+          BuildModule(kBenchEnv, kIgnoreMessages, binary.data(), binary.size());
+      const auto loaded = Clock::now();
+      opt::PassManager manager;
+      manager.AddPass<opt::InlineExhaustivePass>();
+      manager.AddPass<opt::SSARewritePass>();
+      manager.AddPass<opt::AggressiveDCEPass>();
+      const auto status = manager.Run(context.get());
+      const auto optimized = Clock::now();
+      if (status == opt::Pass::Status::Failure) {
+        state.SkipWithError("the passes failed on the input module");
+        return;
+      }
+      arena_bytes = std::max(arena_bytes, context->arena()->bytes_reserved());
+      context.reset();
+      const auto destroyed = Clock::now();
+      load_seconds += std::chrono::duration<double>(loaded - start).count();
+      optimize_seconds +=
+          std::chrono::duration<double>(optimized - loaded).count();
+      destroy_seconds +=
+          std::chrono::duration<double>(destroyed - optimized).count();
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+  state.counters["load_ms"] = benchmark::Counter(
+      load_seconds * 1000, benchmark::Counter::kAvgIterations);
+  state.counters["optimize_ms"] = benchmark::Counter(
+      optimize_seconds * 1000, benchmark::Counter::kAvgIterations);
+  state.counters["destroy_ms"] = benchmark::Counter(
+      destroy_seconds * 1000, benchmark::Counter::kAvgIterations);
+  state.counters["arena_kb"] = static_cast<double>(arena_bytes / 1024);
+#if defined(SPIRV_OPT_USE_ARENA)
+  state.SetLabel("arena");
+#else
+  state.SetLabel("heap");
+#endif
+}
+BENCHMARK(BM_LoadOptimizeDestroy)
+    ->ArgName("functions")
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
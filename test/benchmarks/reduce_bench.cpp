@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the reducer.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "source/reduce/reducer.h"
+#include "spirv-tools/libspirv.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Reduction steps taken per module. Every step re-validates the module, so
+// the limit keeps the large synthetic inputs tractable.
+constexpr uint32_t kReductionStepLimit = 16;
+
+// Runs the default reduction passes with an interestingness test that accepts
+// everything, so the cost is dominated by finding and applying opportunities.
+void BM_Reduce(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  reduce::Reducer reducer(kBenchEnv);
+  reducer.SetInterestingnessFunction(
+      [](const std::vector<uint32_t>&, uint32_t) { return true; });
+  reducer.AddDefaultReductionPasses();
+  ReducerOptions reducer_options;
+  reducer_options.set_step_limit(kReductionStepLimit);
+  ValidatorOptions validator_options;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      std::vector<uint32_t> reduced;
+      reducer.Run(binary, &reduced, reducer_options, validator_options);
+      benchmark::DoNotOptimize(reduced.data());
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_Reduce)->Apply(InputArgs);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
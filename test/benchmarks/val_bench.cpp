@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks for the validator.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "spirv-tools/libspirv.hpp"
+#include "test/benchmarks/bench_util.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+void BM_Validate(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  spv_context context = spvContextCreate(kBenchEnv);
+  ValidatorOptions options;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      spv_const_binary_t words = {binary.data(), binary.size()};
+      benchmark::DoNotOptimize(
+          spvValidateWithOptions(context, options, &words, nullptr));
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+  state.counters["insts/s"] = benchmark::Counter(
+      static_cast<double>(CountInstructions(modules)) *
+          static_cast<double>(state.iterations()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Validate)->Apply(InputArgs);
+
+// Validates modules that are already in a validation cache, which only costs
+// hashing their words.
+void BM_ValidateCached(benchmark::State& state) {
+  const auto& modules = InputModules(state.range(0));
+  SpirvTools tools(kBenchEnv);
+  ValidatorOptions options;
+  InMemoryValidationCache cache(modules.size());
+  for (const auto& binary : modules) {
+    tools.Validate(binary.data(), binary.size(), options, &cache);
+  }
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      benchmark::DoNotOptimize(
+          tools.Validate(binary.data(), binary.size(), options, &cache));
+    }
+  }
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_ValidateCached)->Apply(InputArgs)->Unit(benchmark::kMicrosecond);
+
+// Validates a synthetic library, which has a LinkageAttributes decoration on
+// every function, to track the cost of the decoration tables.
+void BM_ValidateLibrary(benchmark::State& state) {
+  const std::vector<Binary> modules = {MakeSyntheticModule(
+      static_cast<uint32_t>(state.range(0)), /* export_prefix = */ "lib_")};
+  spv_context context = spvContextCreate(kBenchEnv);
+  ValidatorOptions options;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      spv_const_binary_t words = {binary.data(), binary.size()};
+      benchmark::DoNotOptimize(
+          spvValidateWithOptions(context, options, &words, nullptr));
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+}
+BENCHMARK(BM_ValidateLibrary)
+    ->ArgName("functions")
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+// Validates a function whose dominator tree is tens of thousands of blocks
+// deep, to track the cost of dominance queries.
+void BM_ValidateDeepCfg(benchmark::State& state) {
+  const std::vector<Binary> modules = {
+      MakeSelectionChainModule(static_cast<uint32_t>(state.range(0)))};
+  spv_context context = spvContextCreate(kBenchEnv);
+  ValidatorOptions options;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      spv_const_binary_t words = {binary.data(), binary.size()};
+      benchmark::DoNotOptimize(
+          spvValidateWithOptions(context, options, &words, nullptr));
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+  state.counters["blocks"] = static_cast<double>(2 * state.range(0) + 1);
+}
+BENCHMARK(BM_ValidateDeepCfg)
+    ->ArgName("selections")
+    ->Arg(5000)
+    ->Arg(20000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
+
+// Validates a module where most instructions are decorations on tens of
+// thousands of distinct ids and struct members, to track the cost of the
+// decoration tables. Run it alone so that peak_rss_kb is its own.
+void BM_ValidateDecorations(benchmark::State& state) {
+  const std::vector<Binary> modules = {
+      MakeDecoratedBlocksModule(static_cast<uint32_t>(state.range(0)))};
+  spv_context context = spvContextCreate(kBenchEnv);
+  ValidatorOptions options;
+  for (auto _ : state) {
+    for (const auto& binary : modules) {
+      spv_const_binary_t words = {binary.data(), binary.size()};
+      benchmark::DoNotOptimize(
+          spvValidateWithOptions(context, options, &words, nullptr));
+    }
+  }
+  spvContextDestroy(context);
+  ReportCounters(state, CountWords(modules));
+  state.counters["insts/s"] = benchmark::Counter(
+      static_cast<double>(CountInstructions(modules)) *
+          static_cast<double>(state.iterations()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ValidateDecorations)
+    ->ArgName("blocks")
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
@@ -222,6 +222,58 @@ TEST(CppInterface, ValidateWithOptionsFail) {
           "Number of OpTypeStruct members (10) has exceeded the limit (9)"));
 }
 
+TEST(CppInterface, ValidateWithCacheRecordsValidModules) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(10), &binary));
+  ValidatorOptions opts;
+  InMemoryValidationCache cache(4);
+
+  EXPECT_TRUE(t.Validate(binary.data(), binary.size(), opts, &cache));
+  EXPECT_TRUE(cache.Contains(ValidationCache::Key(
+      SPV_ENV_UNIVERSAL_1_1, opts, binary.data(), binary.size())));
+
+  // Different options give a different key, so the module is validated
+  // again, and the failure is reported and not recorded.
+  opts.SetUniversalLimit(spv_validator_limit_max_struct_members, 9);
+  std::stringstream os;
+  t.SetMessageConsumer([&os](spv_message_level_t, const char*,
+                             const spv_position_t&,
+                             const char* message) { os << message; });
+  EXPECT_FALSE(t.Validate(binary.data(), binary.size(), opts, &cache));
+  EXPECT_THAT(os.str(), HasSubstr("has exceeded the limit (9)"));
+  EXPECT_FALSE(cache.Contains(ValidationCache::Key(
+      SPV_ENV_UNIVERSAL_1_1, opts, binary.data(), binary.size())));
+}
+
+TEST(CppInterface, ValidationCacheKeyDependsOnEnvironment) {
+  const std::vector<uint32_t> words = {1, 2, 3};
+  const ValidatorOptions opts;
+  EXPECT_EQ(ValidationCache::Key(SPV_ENV_UNIVERSAL_1_1, opts, words.data(),
+                                 words.size()),
+            ValidationCache::Key(SPV_ENV_UNIVERSAL_1_1, opts, words.data(),
+                                 words.size()));
+  EXPECT_NE(ValidationCache::Key(SPV_ENV_UNIVERSAL_1_1, opts, words.data(),
+                                 words.size()),
+            ValidationCache::Key(SPV_ENV_VULKAN_1_0, opts, words.data(),
+                                 words.size()));
+  EXPECT_NE(ValidationCache::Key(SPV_ENV_UNIVERSAL_1_1, opts, words.data(),
+                                 words.size()),
+            ValidationCache::Key(SPV_ENV_UNIVERSAL_1_1, opts, words.data(),
+                                 words.size() - 1));
+}
+
+TEST(CppInterface, InMemoryValidationCacheEvictsLeastRecentlyUsed) {
+  InMemoryValidationCache cache(2);
+  cache.Insert("a");
+  cache.Insert("b");
+  EXPECT_TRUE(cache.Contains("a"));
+  cache.Insert("c");
+  EXPECT_TRUE(cache.Contains("a"));
+  EXPECT_FALSE(cache.Contains("b"));
+  EXPECT_TRUE(cache.Contains("c"));
+}
+
 // Checks that after running the given optimizer |opt| on the given |original|
 // source code, we can get the given |optimized| source code.
 void CheckOptimization(const std::string& original,
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -425,5 +427,45 @@ TEST_F(HexToText, UnexpectedPrefix) {
 
   EnsureError(kHex);
 }
+
+// Writes |bytes| to a new file in the test temporary directory, and returns
+// its name.
+std::string WriteTempFile(const char* name, const std::vector<char>& bytes) {
+  const std::string filename = ::testing::TempDir() + name;
+  EXPECT_TRUE(WriteFile<char>(filename.c_str(), "wb", bytes.data(),
+                              bytes.size()));
+  return filename;
+}
+
+TEST(ReadBinaryFileTest, MapsBinaryModule) {
+  const std::vector<uint32_t> words = {0x07230203, 0x00010000, 0, 1, 0};
+  const char* begin = reinterpret_cast<const char*>(words.data());
+  const std::string filename = WriteTempFile(
+      "mapped.spv",
+      std::vector<char>(begin, begin + words.size() * sizeof(uint32_t)));
+
+  BinaryFile file;
+  ASSERT_TRUE(ReadBinaryFile(filename.c_str(), &file));
+#if !defined(SPIRV_WINDOWS)
+  EXPECT_TRUE(file.is_mapped());
+#endif
+  EXPECT_EQ(std::vector<uint32_t>(file.data(), file.data() + file.size()),
+            words);
+  std::remove(filename.c_str());
+}
+
+TEST(ReadBinaryFileTest, CopiesHexModule) {
+  const char* hex = "0x07230203, 0x00010000, 0x00000000, 0x00000001, 0x0";
+  const std::string filename =
+      WriteTempFile("copied.spv", std::vector<char>(hex, hex + strlen(hex)));
+
+  BinaryFile file;
+  ASSERT_TRUE(ReadBinaryFile(filename.c_str(), &file));
+  EXPECT_FALSE(file.is_mapped());
+  EXPECT_EQ(std::vector<uint32_t>(file.data(), file.data() + file.size()),
+            std::vector<uint32_t>({0x07230203, 0x00010000, 0, 1, 0}));
+  std::remove(filename.c_str());
+}
+
 }  // namespace
 }  // namespace spvtools
@@ -1714,6 +1714,112 @@ TEST_F(UpdateUsesTest, KeepOldUses) {
 
   EXPECT_TRUE(userFound);
 }
+
+TEST_F(UpdateUsesTest, UsersVisitedInUniqueIdOrder) {
+  const std::vector<const char*> text = {
+      // clang-format off
+      "OpCapability Shader",
+      "OpMemoryModel Logical GLSL450",
+      "OpEntryPoint Vertex %main \"main\"",
+      "%void = OpTypeVoid",
+      "%4 = OpTypeFunction %void",
+      "%uint = OpTypeInt 32 0",
+      "%uint_5 = OpConstant %uint 5",
+      "%25 = OpConstant %uint 25",
+      "%main = OpFunction %void None %4",
+      "%8 = OpLabel",
+      "%9 = OpIAdd %uint %uint_5 %uint_5",
+      "%10 = OpIAdd %uint %9 %25",
+      "%11 = OpIAdd %uint %9 %uint_5",
+      "%12 = OpIAdd %uint %25 %25",
+      "OpReturn",
+      "OpFunctionEnd"
+      // clang-format on
+  };
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, JoinAllInsts(text),
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+
+  DefUseManager* def_use_mgr = context->get_def_use_mgr();
+  auto user_ids = [def_use_mgr](uint32_t id) {
+    std::vector<uint32_t> ids;
+    def_use_mgr->ForEachUser(
+        id, [&ids](Instruction* user) { ids.push_back(user->result_id()); });
+    return ids;
+  };
+  EXPECT_THAT(user_ids(25), ::testing::ElementsAre(10u, 12u));
+
+  // Make %9 use %25 as well. It was created before the other users of %25,
+  // so it has to be visited first.
+  Instruction* inst9 = def_use_mgr->GetDef(9);
+  inst9->SetInOperand(1, {25});
+  def_use_mgr->AnalyzeInstUse(inst9);
+  EXPECT_THAT(user_ids(25), ::testing::ElementsAre(9u, 10u, 12u));
+  EXPECT_EQ(def_use_mgr->NumUsers(25), 3u);
+  EXPECT_EQ(def_use_mgr->NumUses(25), 4u);
+
+  // Removing and adding users back keeps the order.
+  Instruction* inst10 = def_use_mgr->GetDef(10);
+  context->KillInst(inst10);
+  EXPECT_THAT(user_ids(25), ::testing::ElementsAre(9u, 12u));
+  EXPECT_THAT(user_ids(9), ::testing::ElementsAre(11u));
+  def_use_mgr->AnalyzeInstUse(inst9);
+  EXPECT_THAT(user_ids(25), ::testing::ElementsAre(9u, 12u));
+}
+
+TEST_F(UpdateUsesTest, UsersChangedDuringIteration) {
+  const std::vector<const char*> text = {
+      // clang-format off
+      "OpCapability Shader",
+      "OpMemoryModel Logical GLSL450",
+      "OpEntryPoint Vertex %main \"main\"",
+      "%void = OpTypeVoid",
+      "%4 = OpTypeFunction %void",
+      "%uint = OpTypeInt 32 0",
+      "%uint_5 = OpConstant %uint 5",
+      "%25 = OpConstant %uint 25",
+      "%main = OpFunction %void None %4",
+      "%8 = OpLabel",
+      "%9 = OpIAdd %uint %uint_5 %uint_5",
+      "%10 = OpIAdd %uint %9 %25",
+      "%11 = OpIAdd %uint %9 %uint_5",
+      "%12 = OpIAdd %uint %25 %25",
+      "OpReturn",
+      "OpFunctionEnd"
+      // clang-format on
+  };
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, JoinAllInsts(text),
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+
+  DefUseManager* def_use_mgr = context->get_def_use_mgr();
+  Instruction* inst11 = def_use_mgr->GetDef(11);
+  Instruction* inst12 = def_use_mgr->GetDef(12);
+
+  // While %10 is visited, %11 starts to use %25 and %12 stops. %11 comes
+  // after %10, so it is visited, and %12 is removed before it is reached.
+  std::vector<uint32_t> visited;
+  def_use_mgr->ForEachUser(25, [&](Instruction* user) {
+    visited.push_back(user->result_id());
+    if (user->result_id() != 10) return;
+    inst11->SetInOperand(1, {25});
+    def_use_mgr->AnalyzeInstUse(inst11);
+    inst12->SetInOperand(0, {9});
+    inst12->SetInOperand(1, {9});
+    def_use_mgr->AnalyzeInstUse(inst12);
+  });
+  EXPECT_THAT(visited, ::testing::ElementsAre(10u, 11u));
+
+  std::vector<uint32_t> users;
+  def_use_mgr->ForEachUser(
+      25, [&users](Instruction* user) { users.push_back(user->result_id()); });
+  EXPECT_THAT(users, ::testing::ElementsAre(10u, 11u));
+  EXPECT_EQ(def_use_mgr->NumUsers(9), 3u);
+}
 // clang-format on
 
 }  // namespace
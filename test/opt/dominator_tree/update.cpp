@@ -0,0 +1,146 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "source/opt/block_merge_pass.h"
+#include "source/opt/cfg.h"
+#include "source/opt/dominator_analysis.h"
+#include "source/opt/pass.h"
+#include "test/opt/assembly_builder.h"
+#include "test/opt/function_utils.h"
+#include "test/opt/pass_fixture.h"
+#include "test/opt/pass_utils.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using ::testing::ElementsAre;
+using PassClassTest = PassTest<::testing::Test>;
+
+const std::string kHeader = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %6 = OpTypeBool
+          %7 = OpConstantTrue %6
+          %4 = OpFunction %2 None %3
+)";
+
+// Expects |analysis| to give the same answers as a tree of |f| built from
+// scratch.
+void ExpectSameAsRebuilt(IRContext* context, const Function* f,
+                         const DominatorAnalysisBase& analysis) {
+  DominatorTree fresh(analysis.IsPostDominator());
+  fresh.InitializeTree(*context->cfg(), f);
+  for (const BasicBlock& a : *f) {
+    EXPECT_EQ(fresh.ImmediateDominator(&a), analysis.ImmediateDominator(&a))
+        << "block " << a.id();
+    for (const BasicBlock& b : *f) {
+      EXPECT_EQ(fresh.Dominates(&a, &b), analysis.Dominates(&a, &b))
+          << "blocks " << a.id() << " and " << b.id();
+    }
+  }
+}
+
+// Expects the predecessor lists of the blocks of |f| to be the same, in the
+// same order, as in a CFG built from scratch. IRContext::CheckCFG sorts the
+// lists before comparing them, so it does not catch a change of order.
+void ExpectSamePredecessorsAsRebuilt(IRContext* context, const Function* f) {
+  CFG fresh(context->module());
+  for (const BasicBlock& bb : *f) {
+    EXPECT_EQ(fresh.preds(bb.id()), context->cfg()->preds(bb.id()))
+        << "block " << bb.id();
+  }
+}
+
+TEST_F(PassClassTest, BlockMergeKeepsTreesValid) {
+  const std::string text = kHeader + R"(
+          %5 = OpLabel
+               OpSelectionMerge %13 None
+               OpBranchConditional %7 %10 %11
+         %10 = OpLabel
+               OpBranch %12
+         %12 = OpLabel
+               OpBranch %14
+         %14 = OpLabel
+               OpBranch %13
+         %11 = OpLabel
+               OpBranch %13
+         %13 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  Function* f = spvtest::GetFunction(context->module(), 4);
+  context->GetDominatorAnalysis(f);
+  context->GetPostDominatorAnalysis(f);
+
+  BlockMergePass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisCFG |
+                                        IRContext::kAnalysisDominatorAnalysis));
+  EXPECT_THAT(context->cfg()->preds(13), ElementsAre(10, 11));
+  ExpectSamePredecessorsAsRebuilt(context.get(), f);
+
+  DominatorAnalysis* dom = context->GetDominatorAnalysis(f);
+  PostDominatorAnalysis* post_dom = context->GetPostDominatorAnalysis(f);
+  EXPECT_FALSE(dom->IsReachable(12));
+  EXPECT_FALSE(post_dom->IsReachable(14));
+  ExpectSameAsRebuilt(context.get(), f, *dom);
+  ExpectSameAsRebuilt(context.get(), f, *post_dom);
+}
+
+TEST_F(PassClassTest, BlockMergeKeepsPredecessorOrder) {
+  // OpPhi operands follow the order of the predecessors, so merging %10 and
+  // %12 must leave %10 where %12 was in the predecessors of %13.
+  const std::string text = kHeader + R"(
+          %5 = OpLabel
+               OpSelectionMerge %13 None
+               OpBranchConditional %7 %10 %11
+         %10 = OpLabel
+               OpBranch %12
+         %12 = OpLabel
+               OpBranch %13
+         %11 = OpLabel
+               OpBranch %13
+         %13 = OpLabel
+         %15 = OpPhi %6 %7 %12 %7 %11
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  Function* f = spvtest::GetFunction(context->module(), 4);
+  EXPECT_THAT(context->cfg()->preds(13), ElementsAre(12, 11));
+
+  BlockMergePass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisCFG));
+  EXPECT_THAT(context->cfg()->preds(13), ElementsAre(10, 11));
+  ExpectSamePredecessorsAsRebuilt(context.get(), f);
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
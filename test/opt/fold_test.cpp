@@ -15,6 +15,7 @@
 
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,8 @@ namespace opt {
 namespace {
 
 using ::testing::Contains;
+using ::testing::HasSubstr;
+using ::testing::Not;
 
 std::string Disassemble(const std::string& original, IRContext* context,
                         uint32_t disassemble_options = 0) {
@@ -12250,6 +12253,90 @@ INSTANTIATE_TEST_SUITE_P(ImageOperandsBitmaskFoldingTest, MatchingInstructionWit
         , 89, true)
 ));
 
+TEST(FoldingRuleTableTest, FindsRulesByOpcodeAndExtInst) {
+  OpcodeRuleTable<int> rules;
+  rules[spv::Op::OpIAdd].push_back(1);
+  rules[spv::Op::OpIAdd].push_back(2);
+  rules[spv::Op::OpGroupIAddNonUniformAMD].push_back(3);
+
+  EXPECT_THAT(std::vector<int>(rules.Find(spv::Op::OpIAdd).begin(),
+                               rules.Find(spv::Op::OpIAdd).end()),
+              ::testing::ElementsAre(1, 2));
+  EXPECT_EQ(rules.Find(spv::Op::OpGroupIAddNonUniformAMD).size(), 1u);
+  EXPECT_TRUE(rules.Find(spv::Op::OpISub).empty());
+  EXPECT_TRUE(rules.Find(spv::Op::OpMax).empty());
+
+  ExtInstRuleTable<int> ext_rules;
+  ext_rules[{5, 10}].push_back(4);
+  ext_rules[{1, 20}].push_back(5);
+  ext_rules[{5, 10}].push_back(6);
+
+  EXPECT_EQ(ext_rules.Find(5, 10).size(), 2u);
+  EXPECT_EQ(ext_rules.Find(1, 20)[0], 5);
+  EXPECT_TRUE(ext_rules.Find(1, 10).empty());
+}
+
+TEST(FoldingRuleTableTest, CountsHitsAndMisses) {
+  OpcodeRuleTable<int> rules;
+  rules[spv::Op::OpIAdd].push_back(1);
+  EXPECT_TRUE(rules.Find(spv::Op::OpIAdd).stats().empty());
+
+  // Rules added after counting starts are counted too.
+  rules.EnableStatistics();
+  rules[spv::Op::OpIAdd].push_back(2);
+  rules[spv::Op::OpISub].push_back(3);
+
+  const FoldingRuleList<int>& list = rules.Find(spv::Op::OpIAdd);
+  list.RecordResult(0, false);
+  list.RecordResult(0, false);
+  list.RecordResult(1, true);
+  ASSERT_EQ(list.stats().size(), 2u);
+  EXPECT_EQ(list.stats()[0].hits, 0u);
+  EXPECT_EQ(list.stats()[0].misses, 2u);
+  EXPECT_EQ(list.stats()[1].hits, 1u);
+  EXPECT_EQ(rules.Find(spv::Op::OpISub).stats().size(), 1u);
+}
+
+TEST(FoldingRuleStatisticsTest, ReportsRulesTriedByTheFolder) {
+  const std::string text = Header() +
+                           "%main = OpFunction %void None %void_func\n" +
+                           "%main_lab = OpLabel\n" +
+                           "%n = OpVariable %_ptr_int Function\n" +
+                           "%load = OpLoad %int %n\n" +
+                           "%2 = OpIMul %int %load %int_1\n" +
+                           "%3 = OpSDiv %int %load %int_3\n" +
+                           "OpReturn\n" + "OpFunctionEnd";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(context, nullptr);
+
+  InstructionFolder folder(context.get());
+  folder.EnableRuleStatistics();
+  EXPECT_TRUE(folder.FoldInstruction(context->get_def_use_mgr()->GetDef(2)));
+  EXPECT_FALSE(folder.FoldInstruction(context->get_def_use_mgr()->GetDef(3)));
+
+  std::ostringstream out;
+  folder.PrintRuleStatistics(out);
+  const std::string report = out.str();
+  const size_t folding_rules = report.find("Folding rules:\n");
+  ASSERT_NE(folding_rules, std::string::npos);
+  const std::string const_report = report.substr(0, folding_rules);
+  const std::string rule_report = report.substr(folding_rules);
+
+  // Neither instruction folds to a constant, so the constant folding rules
+  // only miss.
+  EXPECT_THAT(const_report,
+              HasSubstr("OpIMul\n  rule 0: 0 hits, 1 misses\n"));
+  EXPECT_THAT(const_report,
+              HasSubstr("OpSDiv\n  rule 0: 0 hits, 1 misses\n"));
+  EXPECT_THAT(const_report, Not(HasSubstr("hits, 0 misses")));
+  // The multiplication by 1 is folded by one of the other rules.
+  EXPECT_THAT(rule_report, HasSubstr("OpIMul\n"));
+  EXPECT_THAT(rule_report, HasSubstr(": 1 hits, 0 misses\n"));
+  EXPECT_THAT(report, Not(HasSubstr("OpIAdd")));
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
@@ -74,6 +74,26 @@ TEST(ModuleTest, ComputeIdBound) {
                 ->ComputeIdBound());
 }
 
+TEST(ModuleTest, ComputeBinarySize) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpName %main "main"
+%void = OpTypeVoid
+%fntype = OpTypeFunction %void
+%main = OpFunction %void None %fntype
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  auto context = BuildModule(text);
+  ASSERT_NE(nullptr, context);
+
+  std::vector<uint32_t> binary = {1, 2, 3};
+  context->module()->ToBinary(&binary, false);
+  EXPECT_EQ(binary.size() - 3, context->module()->ComputeBinarySize());
+  EXPECT_EQ(spv::MagicNumber, binary[3]);
+}
+
 TEST(ModuleTest, OstreamOperator) {
   const std::string text = R"(OpCapability Shader
 OpCapability Linkage
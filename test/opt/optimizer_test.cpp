@@ -27,6 +27,8 @@ namespace opt {
 namespace {
 
 using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Not;
 
 // Return a string that contains the minimum instructions needed to form
 // a valid module.  Other instructions can be appended to this string.
@@ -120,6 +122,70 @@ TEST(Optimizer, CanRunTransformingPassWithAliasedVectors) {
   EXPECT_THAT(disassembly, Eq(Header() + "%void = OpTypeVoid\n"));
 }
 
+TEST(Optimizer, ProfileReportCountsModuleBeforeAndAfterEachPass) {
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  std::vector<uint32_t> binary;
+  tools.Assemble(Header() + R"(OpName %main "main"
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%main = OpFunction %void None %fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)",
+                 &binary);
+
+  std::ostringstream profile;
+  Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
+  opt.SetProfileReport(&profile);
+  opt.RegisterPass(CreateStripDebugInfoPass());
+  opt.RegisterPass(CreateNullPass());
+  ASSERT_TRUE(opt.Run(binary.data(), binary.size(), &binary));
+
+  EXPECT_THAT(profile.str(), HasSubstr("\"name\": \"strip-debug\", "
+                                       "\"changed\": true"));
+  EXPECT_THAT(profile.str(), HasSubstr("\"name\": \"null\", "
+                                       "\"changed\": false"));
+  EXPECT_THAT(profile.str(), HasSubstr("\"hw_counters\": {\"cycles\": "));
+  EXPECT_THAT(profile.str(), HasSubstr("\"peak_rss_growth_kb\": "));
+  // Unknown values are written as null, never as -1.
+  EXPECT_THAT(profile.str(), Not(HasSubstr(": -")));
+  EXPECT_THAT(profile.str(),
+              HasSubstr("\"before\": {\"functions\": 1, \"blocks\": 1, "
+                        "\"instructions\": 10}, \"after\": {\"functions\": "
+                        "1, \"blocks\": 1, \"instructions\": 9}"));
+}
+
+TEST(Optimizer, TraceReportCoversTheRun) {
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  std::vector<uint32_t> binary;
+  tools.Assemble(Header() + R"(OpName %one "one"
+%int = OpTypeInt 32 0
+%one = OpConstant %int 1
+)",
+                 &binary);
+
+  std::ostringstream trace;
+  Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
+  opt.SetTraceReport(&trace);
+  opt.SetValidateAfterAll(true);
+  opt.RegisterPass(CreateStripDebugInfoPass());
+  opt.RegisterPass(CreateEliminateDeadConstantPass());
+  ASSERT_TRUE(opt.Run(binary.data(), binary.size(), &binary));
+
+  EXPECT_THAT(trace.str(), HasSubstr("\"traceEvents\": ["));
+  for (const char* event :
+       {"\"name\": \"Optimizer::Run\", \"cat\": \"optimizer\"",
+        "\"name\": \"PassManager::Run\", \"cat\": \"optimizer\"",
+        "\"name\": \"BuildModule\", \"cat\": \"parse\"",
+        "\"name\": \"strip-debug\", \"cat\": \"pass\"",
+        "\"name\": \"def-use\", \"cat\": \"analysis\"",
+        "\"name\": \"Validate\", \"cat\": \"validate\"",
+        "\"name\": \"ToBinary\", \"cat\": \"serialize\""}) {
+    EXPECT_THAT(trace.str(), HasSubstr(event));
+  }
+}
+
 TEST(Optimizer, CanValidateFlags) {
   Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
   EXPECT_FALSE(opt.FlagHasValidForm("bad-flag"));
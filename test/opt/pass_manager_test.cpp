@@ -14,11 +14,13 @@
 
 #include <initializer_list>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
+#include "source/opt/analysis_report.h"
 #include "source/util/make_unique.h"
 #include "test/opt/module_utils.h"
 #include "test/opt/pass_fixture.h"
@@ -29,6 +31,7 @@ namespace {
 
 using spvtest::GetIdBound;
 using ::testing::Eq;
+using ::testing::HasSubstr;
 
 // A null pass whose constructors accept arguments
 class NullPassWithArgs : public NullPass {
@@ -186,6 +189,131 @@ TEST(PassManager, RecomputeIdBoundAutomatically) {
   EXPECT_THAT(GetIdBound(*context.module()), Eq(201u));
 }
 
+// A pass that makes the module invalid by adding an OpTypeVoid that reuses
+// an existing result id, but claims to have left the module unchanged.
+class BreakModuleQuietlyPass : public Pass {
+ public:
+  const char* name() const override { return "BreakModuleQuietlyPass"; }
+  Status Process() override {
+    auto inst = MakeUnique<Instruction>(context(), spv::Op::OpTypeVoid, 0, 1,
+                                        std::vector<Operand>{});
+    context()->AddType(std::move(inst));
+    return Status::SuccessWithoutChange;
+  }
+};
+
+TEST(PassManager, ValidateAfterAllValidatesFirstPass) {
+  const std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  ASSERT_NE(nullptr, context);
+
+  ValidatorOptions val_options;
+  PassManager manager;
+  manager.SetMessageConsumer([](spv_message_level_t, const char*,
+                                const spv_position_t&, const char*) {});
+  manager.SetValidatorOptions(val_options);
+  manager.SetValidateAfterAll(true);
+  manager.AddPass<BreakModuleQuietlyPass>();
+  EXPECT_EQ(Pass::Status::Failure, manager.Run(context.get()));
+}
+
+TEST(PassManager, ValidateAfterAllCatchesPassThatReportsNoChange) {
+  const std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  ASSERT_NE(nullptr, context);
+
+  // The module is valid after the null pass. The next pass breaks it but
+  // reports no change, and validation must still catch it.
+  ValidatorOptions val_options;
+  PassManager manager;
+  manager.SetMessageConsumer([](spv_message_level_t, const char*,
+                                const spv_position_t&, const char*) {});
+  manager.SetValidatorOptions(val_options);
+  manager.SetValidateAfterAll(true);
+  manager.AddPass<NullPass>();
+  manager.AddPass<BreakModuleQuietlyPass>();
+  EXPECT_EQ(Pass::Status::Failure, manager.Run(context.get()));
+}
+
+// A pass that uses the def-use manager and does not preserve it.
+class UseDefUsePass : public Pass {
+ public:
+  const char* name() const override { return "UseDefUse"; }
+  Status Process() override {
+    context()->get_def_use_mgr();
+    context()->AddDebug1Inst(MakeUnique<Instruction>(context()));
+    return Status::SuccessWithChange;
+  }
+};
+
+TEST(AnalysisReport, ChargesBuildsToLastInvalidator) {
+  const std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  ASSERT_NE(nullptr, context);
+  context->InvalidateAnalyses(IRContext::kAnalysisDefUse |
+                              IRContext::kAnalysisLoopAnalysis);
+
+  AnalysisReport report;
+  context->SetAnalysisReport(&report);
+  report.BeginPass("first");
+  context->get_def_use_mgr();
+  // Analyses that are not valid are not reported as invalidated.
+  context->InvalidateAnalyses(IRContext::kAnalysisDefUse |
+                              IRContext::kAnalysisLoopAnalysis);
+  report.BeginPass("second");
+  context->get_def_use_mgr();
+  context->SetAnalysisReport(nullptr);
+
+  const uint32_t def_use = 0;
+  ASSERT_EQ(2u, report.entries().size());
+  const AnalysisReport::PassEntry& first = report.entries()[0];
+  const AnalysisReport::PassEntry& second = report.entries()[1];
+  EXPECT_STREQ("def-use", AnalysisReport::AnalysisName(def_use));
+  EXPECT_EQ(uint32_t(IRContext::kAnalysisDefUse), first.invalidated);
+  EXPECT_EQ(1u, first.builds[def_use].count);
+  EXPECT_EQ(1u, first.caused_builds[def_use].count);
+  EXPECT_EQ(0u, second.invalidated);
+  EXPECT_EQ(1u, second.builds[def_use].count);
+  EXPECT_EQ(0u, second.caused_builds[def_use].count);
+}
+
+TEST(PassManager, AnalysisReport) {
+  const std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  ASSERT_NE(nullptr, context);
+
+  std::ostringstream out;
+  PassManager manager;
+  manager.SetAnalysisReport(&out);
+  manager.AddPass<UseDefUsePass>();
+  manager.AddPass<UseDefUsePass>();
+  EXPECT_EQ(Pass::Status::SuccessWithChange, manager.Run(context.get()));
+  EXPECT_EQ(nullptr, context->analysis_report());
+  EXPECT_THAT(out.str(), HasSubstr("invalidated: def-use"));
+  EXPECT_THAT(out.str(), HasSubstr("Builds caused by passes"));
+  EXPECT_THAT(out.str(), HasSubstr("def-use           UseDefUse\n"));
+}
+
 }  // anonymous namespace
 }  // namespace opt
 }  // namespace spvtools
@@ -170,6 +170,59 @@ OpMemoryModel Logical GLSL450
   EXPECT_EQ(GetErrorMessage(), "");
 }
 
+TEST_F(RemoveDuplicatesTest, InterleavedDuplicateTypesKeepFirst) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeInt 32 0
+%2 = OpTypeFloat 32
+%3 = OpTypeInt 32 0
+%4 = OpTypeVector %2 4
+%5 = OpTypeFloat 32
+%6 = OpTypeVector %5 4
+%7 = OpTypeStruct %3 %6
+%8 = OpTypeStruct %1 %4
+)";
+  const std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeInt 32 0
+%2 = OpTypeFloat 32
+%4 = OpTypeVector %2 4
+%7 = OpTypeStruct %1 %4
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
+TEST_F(RemoveDuplicatesTest, DuplicateForwardPointers) {
+  const std::string spirv = R"(
+OpCapability Addresses
+OpCapability Kernel
+OpCapability Linkage
+OpMemoryModel Physical32 OpenCL
+OpTypeForwardPointer %1 CrossWorkgroup
+OpTypeForwardPointer %1 CrossWorkgroup
+%2 = OpTypeInt 32 0
+%3 = OpTypeStruct %2 %1
+%1 = OpTypePointer CrossWorkgroup %3
+)";
+  const std::string after = R"(OpCapability Addresses
+OpCapability Kernel
+OpCapability Linkage
+OpMemoryModel Physical32 OpenCL
+OpTypeForwardPointer %1 CrossWorkgroup
+%2 = OpTypeInt 32 0
+%3 = OpTypeStruct %2 %1
+%1 = OpTypePointer CrossWorkgroup %3
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
 TEST_F(RemoveDuplicatesTest, SameTypeDifferentMemberDecoration) {
   const std::string spirv = R"(
 OpCapability Shader
@@ -22,6 +22,24 @@ namespace spvtools {
 namespace utils {
 namespace {
 
+// The hardware counter columns that Timer::Report() prints when the library is
+// built with SPIRV_PERF_COUNTERS_ENABLED, for the counts of the mocks below.
+#if defined(SPIRV_PERF_COUNTERS_ENABLED)
+#define PERF_HEADER \
+  "          Cycles    Instructions  Cache misses Branch misses"
+#define PERF_COUNTS \
+  "            1000            2000            30            40"
+#define PERF_COUNTS_TWICE \
+  "            2000            4000            60            80"
+#else
+#define PERF_HEADER ""
+#define PERF_COUNTS ""
+#define PERF_COUNTS_TWICE ""
+#endif
+
+// Fixed hardware counts for the mocks below, one per PerfCounter.
+const long long kMockPerfCounts[kNumPerfCounters] = {1000, 2000, 30, 40};
+
 // A mock class to mimic Timer class for a testing purpose. It has fixed
 // CPU/WALL/USR/SYS time, RSS delta, and the delta of the number of page faults.
 class MockTimer : public Timer {
@@ -34,6 +52,9 @@ class MockTimer : public Timer {
   double SystemTime() override { return 0.002723; }
   long RSS() const override { return 360L; }
   long PageFault() const override { return 3600L; }
+  long long PerfCount(PerfCounter counter) const override {
+    return kMockPerfCounts[counter];
+  }
 };
 
 // This unit test checks whether the actual output of MockTimer::Report() is the
@@ -57,8 +78,9 @@ TEST(MockTimer, DoNothing) {
   EXPECT_EQ(0.002723, timer.SystemTime());
   EXPECT_EQ(
       "                     PASS name    CPU time   WALL time    USR time"
-      "    SYS time\n                     TimerTest        0.02        0.02"
-      "        0.01        0.00\n",
+      "    SYS time" PERF_HEADER
+      "\n                     TimerTest        0.02        0.02"
+      "        0.01        0.00" PERF_COUNTS "\n",
       buf.str());
 }
 
@@ -75,7 +97,7 @@ TEST(MockTimer, TestScopedTimer) {
 
   EXPECT_EQ(
       "               ScopedTimerTest        0.02        0.02        0.01"
-      "        0.00\n",
+      "        0.00" PERF_COUNTS "\n",
       buf.str());
 }
 
@@ -95,6 +117,9 @@ class MockCumulativeTimer : public CumulativeTimer {
   double SystemTime() override { return count_stop_ * 0.002723; }
   long RSS() const override { return count_stop_ * 360L; }
   long PageFault() const override { return count_stop_ * 3600L; }
+  long long PerfCount(PerfCounter counter) const override {
+    return count_stop_ * kMockPerfCounts[counter];
+  }
 
   // Calling Stop() does nothing but just increases |count_stop_| by 1.
   void Stop() override { ++count_stop_; }
@@ -131,7 +156,7 @@ TEST(MockCumulativeTimer, DoNothing) {
 
   EXPECT_EQ(
       "           CumulativeTimerTest        0.04        0.04        0.03"
-      "        0.01\n",
+      "        0.01" PERF_COUNTS_TWICE "\n",
       buf.str());
 
   if (ctimer) delete ctimer;
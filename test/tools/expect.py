@@ -351,6 +351,45 @@ class ValidNamedObjectFile(SuccessfulReturn, CorrectObjectFilePreamble):
     return True, ''
 
 
+class ValidNamedObjectFile1_6WithAssemblySubstr(SuccessfulReturn,
+                                                CorrectObjectFilePreamble):
+  """Mixin class for checking that a list of SPIR-V 1.6 object files with the
+    given names are correctly generated, that the disassembly of each of them
+    contains the matching substring, and there is no output on stdout/stderr.
+
+    To mix in this class, subclasses need to provide expected_object_filenames
+    as the expected object filenames, and expected_assembly_substrs as the
+    substring expected in the disassembly of each of them, in the same order.
+    """
+
+  def check_object_file_disassembly(self, status):
+    if len(self.expected_object_filenames) != len(
+        self.expected_assembly_substrs):
+      return False, 'Need one expected_assembly_substrs entry per object file'
+    for object_filename, assembly_substr in zip(self.expected_object_filenames,
+                                                self.expected_assembly_substrs):
+      obj_file = os.path.join(status.directory, object_filename)
+      success, message = self.verify_object_file_preamble(obj_file, 0x10600)
+      if not success:
+        return False, message
+      cmd = [status.test_manager.disassembler_path, '--no-color', obj_file]
+      process = subprocess.Popen(
+          args=cmd,
+          stdin=subprocess.PIPE,
+          stdout=subprocess.PIPE,
+          stderr=subprocess.PIPE,
+          cwd=status.directory)
+      output = process.communicate(None)
+      disassembly = convert_to_unix_line_endings(output[0].decode('utf-8'))
+      if assembly_substr not in disassembly:
+        return False, ('Incorrect disassembly output for {obj}:\n{asm}\n'
+                       'Expected substring not found:\n{exp}'.format(
+                           obj=object_filename,
+                           asm=disassembly,
+                           exp=assembly_substr))
+    return True, ''
+
+
 class ValidFileContents(SpirvTest):
   """Mixin class to test that a specific file contains specific text
     To mix in this class, subclasses need to provide expected_file_contents as
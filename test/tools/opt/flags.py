@@ -355,3 +355,75 @@ class TestLoopPeelingThresholdArgsInvalidNumber(expect.ErrorMessageSubstr):
 
   spirv_args = ['--loop-peeling-threshold=a10f']
   expected_error_substr = 'must have a positive integer argument'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchWithOutputFile(expect.ErrorMessageSubstr):
+  """Tests that --batch cannot be combined with -o."""
+
+  spirv_args = ['--batch', 'modules.txt', '-o', 'out.spv']
+  expected_error_substr = '--batch cannot be combined with an input file or -o'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchMissingListFile(expect.ErrorMessageSubstr):
+  """Tests that --batch reports a list file that cannot be read."""
+
+  spirv_args = ['--batch=does-not-exist.txt']
+  expected_error_substr = "Could not read batch list file 'does-not-exist.txt'"
+
+
+def named_main_assembly(entry_point_name):
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "{name}"
+         OpName %4 "{name}_function"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %4 = OpFunction %2 None %3
+    %5 = OpLabel
+         OpReturn
+         OpFunctionEnd""".format(name=entry_point_name)
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchOptimizesEachModule(
+    expect.ValidNamedObjectFile1_6WithAssemblySubstr):
+  """Tests that --batch optimizes every module in the list file and writes
+  each one to its own output file."""
+
+  outputs = [
+      placeholder.TempFileName('first.spv'),
+      placeholder.TempFileName('second.spv'),
+      placeholder.TempFileName('third.spv'),
+  ]
+  batch = placeholder.BatchListFile([
+      (placeholder.FileSPIRVShader(named_main_assembly('first'), '.spvasm'),
+       outputs[0]),
+      (placeholder.FileSPIRVShader(named_main_assembly('second'), '.spvasm'),
+       outputs[1]),
+      (placeholder.FileSPIRVShader(named_main_assembly('third'), '.spvasm'),
+       outputs[2]),
+  ])
+  spirv_args = [batch, '--strip-debug']
+  expected_object_filenames = outputs
+  # --strip-debug removes the OpName, so the function has no friendly name.
+  expected_assembly_substrs = [
+      'OpEntryPoint Vertex %1 "first"',
+      'OpEntryPoint Vertex %1 "second"',
+      'OpEntryPoint Vertex %1 "third"',
+  ]
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchReportsUnreadableModule(expect.ErrorMessageSubstr):
+  """Tests that --batch reports a module that cannot be read together with
+  the failure of that module."""
+
+  batch = placeholder.BatchListFile([
+      (placeholder.TempFileName('does-not-exist.spv'),
+       placeholder.TempFileName('out.spv')),
+  ])
+  spirv_args = [batch]
+  expected_error_substr = "error: file does not exist '"
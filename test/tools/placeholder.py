@@ -116,6 +116,42 @@ class ConfigFlagsFile(PlaceHolder):
     return self.filename
 
 
+class BatchListFile(PlaceHolder):
+  """Stands for a --batch list file for spirv-opt.
+
+    Each job is a pair of placeholders for an input file and an output file,
+    written to the list file on one line.
+    """
+
+  def __init__(self, jobs):
+    assert isinstance(jobs, list)
+    self.jobs = jobs
+    self.filename = None
+
+  def instantiate_for_spirv_args(self, testcase):
+    """Instantiates the input and output files and writes their names into a
+        temporary file.
+
+        Returns:
+            The --batch flag naming the temporary file.
+    """
+    lines = [
+        '%s %s\n' % (in_file.instantiate_for_spirv_args(testcase),
+                     out_file.instantiate_for_spirv_args(testcase))
+        for in_file, out_file in self.jobs
+    ]
+    temp_fd, self.filename = tempfile.mkstemp(
+        dir=testcase.directory, suffix='.txt')
+    fd = os.fdopen(temp_fd, 'w')
+    fd.writelines(lines)
+    fd.close()
+    return '--batch=%s' % self.filename
+
+  def instantiate_for_expectation(self, testcase):
+    assert self.filename is not None
+    return self.filename
+
+
 class FileSPIRVShader(PlaceHolder):
   """Stands for a source shader file which must be converted to SPIR-V."""
 
@@ -0,0 +1,169 @@
+# Copyright (c) 2026 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import subprocess
+
+import placeholder
+import expect
+
+from spirv_test_framework import inside_spirv_testsuite
+
+CACHE_DIR = 'cache'
+
+
+def empty_main_assembly():
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "main"
+         OpName %4 "main"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %4 = OpFunction %2 None %3
+    %5 = OpLabel
+         OpReturn
+         OpFunctionEnd"""
+
+
+def invalid_assembly():
+  # The function type returns void, but the function is declared to return an
+  # int.
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "main"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %6 = OpTypeInt 32 0
+    %4 = OpFunction %6 None %3
+    %5 = OpLabel
+         OpReturn
+         OpFunctionEnd"""
+
+
+class CacheDirTest(expect.SuccessfulReturn):
+  """Base class for tests that run spirv-val with --cache-dir.
+
+    The first run is made by the test framework. Subclasses may run spirv-val
+    again with the same arguments through run_again().
+    """
+
+  def cache_entries(self, status):
+    """Returns the paths of the files in the cache directory."""
+    cache_dir = os.path.join(status.directory, CACHE_DIR)
+    if not os.path.isdir(cache_dir):
+      return []
+    return [os.path.join(cache_dir, name) for name in os.listdir(cache_dir)]
+
+  def is_valid_entry(self, path):
+    """Returns true if the file at path holds its own name, the cache key."""
+    with open(path, 'r') as f:
+      return f.read() == os.path.basename(path) + '\n'
+
+  def run_again(self, status):
+    """Runs spirv-val again with the same arguments.
+
+        Returns:
+            False, error string if spirv-val fails or prints anything
+            True, '' otherwise
+        """
+    process = subprocess.Popen(
+        args=[status.test_manager.executable_path] + self.spirv_args,
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        cwd=status.directory)
+    output = process.communicate(None)
+    if process.returncode != 0 or output[0] or output[1]:
+      return False, ('Second run failed with code {code}:\n{out}\n{err}'.format(
+          code=process.returncode, out=output[0], err=output[1]))
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvValCacheDir')
+class TestCacheDirWritesEntry(CacheDirTest):
+  """Tests that a valid module is recorded in the cache directory."""
+
+  shader = placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm')
+  spirv_args = [shader, '--cache-dir', placeholder.TempFileName(CACHE_DIR)]
+
+  def check_cache_entry_written(self, status):
+    entries = self.cache_entries(status)
+    if len(entries) != 1:
+      return False, 'Expected one cache entry, found %d' % len(entries)
+    if not self.is_valid_entry(entries[0]):
+      return False, 'Cache entry does not hold its key: %s' % entries[0]
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvValCacheDir')
+class TestCacheDirReusesEntry(CacheDirTest):
+  """Tests that validating the same module again uses the cache entry instead
+  of writing it again."""
+
+  shader = placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm')
+  spirv_args = [shader, '--cache-dir', placeholder.TempFileName(CACHE_DIR)]
+
+  def check_cache_entry_reused(self, status):
+    entries = self.cache_entries(status)
+    if len(entries) != 1:
+      return False, 'Expected one cache entry, found %d' % len(entries)
+    # Only a module that was validated writes its entry, so an entry that
+    # keeps this time was found in the cache.
+    os.utime(entries[0], (0, 0))
+    success, message = self.run_again(status)
+    if not success:
+      return False, message
+    if self.cache_entries(status) != entries:
+      return False, 'The second run changed the cache entries'
+    if os.stat(entries[0]).st_mtime != 0:
+      return False, 'The second run wrote the cache entry again'
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvValCacheDir')
+class TestCacheDirIgnoresCorruptEntry(CacheDirTest):
+  """Tests that a cache entry that does not hold its key is ignored, and is
+  written again once the module has been validated."""
+
+  shader = placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm')
+  spirv_args = [shader, '--cache-dir', placeholder.TempFileName(CACHE_DIR)]
+
+  def check_corrupt_cache_entry_ignored(self, status):
+    entries = self.cache_entries(status)
+    if len(entries) != 1:
+      return False, 'Expected one cache entry, found %d' % len(entries)
+    with open(entries[0], 'w') as f:
+      f.write('corrupt')
+    success, message = self.run_again(status)
+    if not success:
+      return False, message
+    if not self.is_valid_entry(entries[0]):
+      return False, 'The corrupt cache entry was not written again'
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvValCacheDir')
+class TestCacheDirSkipsInvalidModule(expect.ReturnCodeIsNonZero):
+  """Tests that an invalid module is not recorded in the cache directory."""
+
+  shader = placeholder.FileSPIRVShader(invalid_assembly(), '.spvasm')
+  spirv_args = [shader, '--cache-dir', placeholder.TempFileName(CACHE_DIR)]
+
+  def check_no_cache_entry(self, status):
+    cache_dir = os.path.join(status.directory, CACHE_DIR)
+    if os.path.isdir(cache_dir) and os.listdir(cache_dir):
+      return False, 'Invalid module was recorded in the cache'
+    return True, ''
@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/arena.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+TEST(ArenaTest, AllocationsAreAlignedAndDistinct) {
+  Arena arena;
+  std::set<void*> seen;
+  for (size_t size = 0; size < 200; ++size) {
+    void* ptr = arena.Allocate(size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t),
+              0u);
+    EXPECT_TRUE(seen.insert(ptr).second);
+    memset(ptr, 0xab, size);
+  }
+}
+
+TEST(ArenaTest, ReusesDeallocatedMemory) {
+  Arena arena;
+  void* first = arena.Allocate(48);
+  arena.Deallocate(first, 48);
+  EXPECT_EQ(arena.Allocate(40), first);
+}
+
+TEST(ArenaTest, LargeAllocationsBypassTheBlocks) {
+  Arena arena;
+  void* ptr = arena.Allocate(1 << 20);
+  memset(ptr, 0, 1 << 20);
+  EXPECT_EQ(arena.bytes_reserved(), 0u);
+  arena.Deallocate(ptr, 1 << 20);
+}
+
+TEST(ArenaTest, ScopesNest) {
+  Arena outer;
+  Arena inner;
+  EXPECT_EQ(ArenaScope::current(), nullptr);
+  {
+    ArenaScope outer_scope(&outer);
+    EXPECT_EQ(ArenaScope::current(), &outer);
+    {
+      ArenaScope inner_scope(&inner);
+      EXPECT_EQ(ArenaScope::current(), &inner);
+    }
+    EXPECT_EQ(ArenaScope::current(), &outer);
+  }
+  EXPECT_EQ(ArenaScope::current(), nullptr);
+}
+
+struct Node : public ArenaObject {
+  explicit Node(int v) : value(v) {}
+  virtual ~Node() = default;
+  int value;
+};
+
+TEST(ArenaTest, ArenaObjectsOutliveTheirScope) {
+  Arena arena;
+  std::vector<std::unique_ptr<Node>> nodes;
+  {
+    ArenaScope scope(&arena);
+    for (int i = 0; i < 10000; ++i) {
+      nodes.push_back(std::unique_ptr<Node>(new Node(i)));
+    }
+  }
+  // Objects created outside of a scope come from the heap, and can be mixed
+  // freely with the ones from the arena.
+  nodes.push_back(std::unique_ptr<Node>(new Node(10000)));
+  for (int i = 0; i <= 10000; ++i) {
+    EXPECT_EQ(nodes[i]->value, i);
+  }
+  nodes.clear();
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
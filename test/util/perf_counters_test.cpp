@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/perf_counters.h"
+
+#include "gmock/gmock.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+TEST(PerfCountersTest, Names) {
+  EXPECT_STREQ("cycles", PerfCounterName(kPerfCycles));
+  EXPECT_STREQ("instructions", PerfCounterName(kPerfInstructions));
+  EXPECT_STREQ("cache-misses", PerfCounterName(kPerfCacheMisses));
+  EXPECT_STREQ("branch-misses", PerfCounterName(kPerfBranchMisses));
+}
+
+// Counters may be unavailable even when they are built in, for example in a
+// container or a virtual machine, so only check that each counter either
+// counts or reports -1.
+TEST(PerfCountersTest, CountsOrReportsUnavailable) {
+  PerfCounters counters;
+  counters.Start();
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 100000; ++i) sum = sum + i;
+  counters.Stop();
+
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    const PerfCounter counter = PerfCounter(i);
+    if (!PerfCountersBuiltIn()) {
+      EXPECT_FALSE(counters.IsAvailable(counter));
+    }
+    if (counters.IsAvailable(counter)) {
+      EXPECT_GE(counters.Count(counter), 0) << PerfCounterName(counter);
+    } else {
+      EXPECT_EQ(-1, counters.Count(counter)) << PerfCounterName(counter);
+    }
+  }
+}
+
+TEST(PerfCountersTest, CountIsUnknownBeforeStop) {
+  PerfCounters counters;
+  counters.Start();
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    EXPECT_EQ(-1, counters.Count(PerfCounter(i)));
+  }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
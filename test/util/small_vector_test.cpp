@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <iterator>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -268,6 +270,31 @@ TEST(SmallVectorTest, Initialize_iterators_write2) {
   }
 }
 
+TEST(SmallVectorTest, Initialize_input_iterators1) {
+  std::istringstream in("0 1");
+  SmallVector<uint32_t, 2> vec{std::istream_iterator<uint32_t>(in),
+                               std::istream_iterator<uint32_t>()};
+
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[0], 0);
+  EXPECT_EQ(vec[1], 1);
+}
+
+TEST(SmallVectorTest, Initialize_input_iterators2) {
+  std::istringstream in("0 1 2 3");
+  SmallVector<uint32_t, 2> vec{std::istream_iterator<uint32_t>(in),
+                               std::istream_iterator<uint32_t>()};
+
+  EXPECT_EQ(vec.size(), 4);
+  uint32_t result[] = {0, 1, 2, 3};
+
+  uint32_t i = 0;
+  for (uint32_t p : vec) {
+    EXPECT_EQ(p, result[i]);
+    i++;
+  }
+}
+
 TEST(SmallVectorTest, Initialize_front) {
   SmallVector<uint32_t, 2> vec = {0, 1, 2, 3};
 
@@ -667,6 +694,28 @@ TEST(SmallVectorTest, Pop_back_TestDestructor) {
   EXPECT_EQ(num_dtors, num_ctors);
 }
 
+TEST(SmallVectorTest, NoPerObjectOverhead) {
+  // The inline elements, the count, and the pointer to the large storage.
+  EXPECT_EQ(sizeof(SmallVector<uint32_t, 2>),
+            2 * sizeof(uint32_t) + sizeof(size_t) + sizeof(void*));
+}
+
+TEST(SmallVectorTest, CopyAfterMove) {
+  SmallVector<uint32_t, 2> vec = {1, 2};
+  std::vector<SmallVector<uint32_t, 2>> vecs;
+  for (uint32_t i = 0; i < 8; ++i) {
+    vecs.push_back(vec);
+    vec[0] = i;
+  }
+
+  for (uint32_t i = 0; i < 8; ++i) {
+    SmallVector<uint32_t, 2> copy = vecs[i];
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy[0], i == 0 ? 1 : i - 1);
+    EXPECT_EQ(copy[1], 2);
+  }
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace spvtools
@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/thread_pool.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+TEST(ThreadPoolTest, NumThreadsCountsCaller) {
+  EXPECT_EQ(ThreadPool(0).num_threads(), 1u);
+  EXPECT_EQ(ThreadPool(1).num_threads(), 1u);
+  EXPECT_EQ(ThreadPool(4).num_threads(), 4u);
+}
+
+TEST(ThreadPoolTest, HardwareConcurrencyIsPositive) {
+  EXPECT_GE(ThreadPool::HardwareConcurrency(), 1u);
+}
+
+TEST(ThreadPoolTest, EmptyRangeRunsNothing) {
+  ThreadPool pool(4);
+  std::atomic<int> calls(0);
+  pool.ParallelFor(0, [&calls](size_t) { ++calls; });
+  EXPECT_EQ(calls.load(), 0);
+}
+
+TEST(ThreadPoolTest, SerialPoolRunsEveryIndexInOrder) {
+  ThreadPool pool(1);
+  std::vector<size_t> order;
+  pool.ParallelFor(5, [&order](size_t i) { order.push_back(i); });
+  EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST(ThreadPoolTest, RunsEveryIndexExactlyOnce) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> counts(1000);
+  for (auto& count : counts) count = 0;
+  pool.ParallelFor(counts.size(), [&counts](size_t i) { ++counts[i]; });
+  for (const auto& count : counts) EXPECT_EQ(count.load(), 1);
+}
+
+TEST(ThreadPoolTest, PoolIsReusable) {
+  ThreadPool pool(3);
+  for (int round = 0; round < 50; ++round) {
+    std::vector<int> results(64, 0);
+    pool.ParallelFor(results.size(), [&results, round](size_t i) {
+      results[i] = static_cast<int>(i) + round;
+    });
+    for (size_t i = 0; i < results.size(); ++i) {
+      EXPECT_EQ(results[i], static_cast<int>(i) + round);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, SlotsAreIndependentOfThreadCount) {
+  auto run = [](uint32_t num_threads) {
+    ThreadPool pool(num_threads);
+    std::vector<uint32_t> squares(257);
+    pool.ParallelFor(squares.size(), [&squares](size_t i) {
+      squares[i] = static_cast<uint32_t>(i * i);
+    });
+    return squares;
+  };
+  const auto serial = run(1);
+  EXPECT_EQ(run(2), serial);
+  EXPECT_EQ(run(8), serial);
+  EXPECT_EQ(serial[16], 256u);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
@@ -461,6 +461,49 @@ TEST_P(ValidateCFG, MergeBlockTargetedByMultipleHeaderBlocksSelectionBad) {
   }
 }
 
+TEST_P(ValidateCFG, BlockAppearsBeforeDominatorBadSameErrorWithThreads) {
+  bool is_shader = GetParam() == spv::Capability::Shader;
+  const int kNumFunctions = 100;
+  std::string names;
+  std::string body;
+  for (int i = 0; i < kNumFunctions; ++i) {
+    const std::string suffix = std::to_string(i);
+    Block entry("entry" + suffix);
+    Block cont("cont" + suffix);
+    Block branch("branch" + suffix, spv::Op::OpBranchConditional);
+    Block merge("merge" + suffix, spv::Op::OpReturn);
+
+    if (is_shader) {
+      branch.SetBody("OpSelectionMerge %merge" + suffix + " None\n");
+    }
+
+    names += nameOps("cont" + suffix, "branch" + suffix);
+    body += "%func" + suffix + " = OpFunction %voidt None %funct\n";
+    body += entry >> branch;
+    if (i == 40 || i == 70) {
+      body += cont >> merge;  // cont appears before its dominator
+      body += branch >> std::vector<Block>({cont, merge});
+    } else {
+      body += branch >> std::vector<Block>({cont, merge});
+      body += cont >> merge;
+    }
+    body += merge;
+    body += "OpFunctionEnd\n";
+  }
+
+  // Every branch shares a module-scope condition.
+  CompileSuccessfully(GetDefaultHeader(GetParam()) + names + types_consts() +
+                      "%cond = OpConstantTrue %boolt\n" + body);
+  ASSERT_EQ(SPV_ERROR_INVALID_CFG, ValidateInstructions());
+  const std::string expected = getDiagnosticString();
+  EXPECT_THAT(expected, HasSubstr("[%cont40]' appears in the binary before "
+                                  "its dominator"));
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_ERROR_INVALID_CFG, ValidateInstructions());
+  EXPECT_EQ(expected, getDiagnosticString());
+}
+
 TEST_P(ValidateCFG, BranchTargetFirstBlockBadSinceEntryBlock) {
   Block entry("entry");
   Block bad("bad");
@@ -103,6 +103,56 @@ TEST_F(ValidateDecorations, ValidateOpMemberDecorateRegistration) {
                               Decoration(spv::Decoration::BufferBlock)}));
 }
 
+TEST_F(ValidateDecorations, DecoratedIdsInIncreasingOrder) {
+  std::string spirv = R"(
+    OpCapability Shader
+    OpCapability Linkage
+    OpMemoryModel Logical GLSL450
+    OpName %a "a"
+    OpName %b "b"
+    OpDecorate %b Location 1
+    OpDecorate %a Location 0
+    %float = OpTypeFloat 32
+    %ptr = OpTypePointer Output %float
+    %a = OpVariable %ptr Output
+    %b = OpVariable %ptr Output
+)";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  // %b is decorated first, but has the larger id.
+  EXPECT_THAT(vstate_->DecoratedIds(), Eq(std::vector<uint32_t>{1, 2}));
+  ASSERT_NE(nullptr, vstate_->FindDecorations(2));
+  EXPECT_THAT(*vstate_->FindDecorations(2),
+              Eq(std::set<Decoration>{
+                  Decoration(spv::Decoration::Location, {1})}));
+}
+
+TEST_F(ValidateDecorations, BuiltInDecoratedIdsInIncreasingOrder) {
+  std::string spirv = R"(
+    OpCapability Shader
+    OpCapability Linkage
+    OpMemoryModel Logical GLSL450
+    OpName %a "a"
+    OpName %b "b"
+    OpName %s "s"
+    OpDecorate %b BuiltIn FragCoord
+    OpDecorate %a Location 0
+    OpMemberDecorate %s 0 BuiltIn Position
+    OpDecorate %s Block
+    %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+    %s = OpTypeStruct %v4float
+    %ptr = OpTypePointer Input %v4float
+    %a = OpVariable %ptr Input
+    %b = OpVariable %ptr Input
+)";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  // %a has no BuiltIn decoration, and %s has one on a member.
+  EXPECT_THAT(vstate_->builtin_decorated_ids(),
+              Eq(std::set<uint32_t>{2, 3}));
+}
+
 TEST_F(ValidateDecorations, ValidateOpMemberDecorateOutOfBound) {
   std::string spirv = R"(
                OpCapability Shader
@@ -6600,6 +6650,48 @@ OpFunctionEnd
                         "stride 4 not satisfying alignment to 16"));
 }
 
+TEST_F(ValidateDecorations, SharedArrayCheckedWithEachBufferRule) {
+  // The storage buffer is checked first and accepts the array. The uniform
+  // buffer must still reject it under its own rules.
+  const std::string spirv = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+OpDecorate %ssbo Block
+OpMemberDecorate %ssbo 0 Offset 0
+OpDecorate %ubo Block
+OpMemberDecorate %ubo 0 Offset 0
+OpDecorate %array ArrayStride 4
+OpDecorate %ssbo_var DescriptorSet 0
+OpDecorate %ssbo_var Binding 0
+OpDecorate %ubo_var DescriptorSet 0
+OpDecorate %ubo_var Binding 1
+%void = OpTypeVoid
+%int = OpTypeInt 32 0
+%int_4 = OpConstant %int 4
+%array = OpTypeArray %int %int_4
+%ssbo = OpTypeStruct %array
+%ubo = OpTypeStruct %array
+%ptr_ssbo = OpTypePointer StorageBuffer %ssbo
+%ptr_ubo = OpTypePointer Uniform %ubo
+%ssbo_var = OpVariable %ptr_ssbo StorageBuffer
+%ubo_var = OpVariable %ptr_ubo Uniform
+%void_fn = OpTypeFunction %void
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_1);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_VULKAN_1_1));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Uniform storage class must follow relaxed uniform "
+                        "buffer layout rules: member 0 contains an array with "
+                        "stride 4 not satisfying alignment to 16"));
+}
+
 TEST_F(ValidateDecorations, ImproperStraddleInArray) {
   const std::string spirv = R"(
 OpCapability Shader
@@ -0,0 +1,248 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for the table of passes that handle each opcode.
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/table.h"
+#include "source/val/instruction.h"
+#include "source/val/validate.h"
+#include "source/val/validation_state.h"
+#include "spirv-tools/libspirv.hpp"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using Passes = std::vector<InstructionPass>;
+
+TEST(ValidatePassTable, ArithmeticOpcodeRunsItsPassesInOrder) {
+  EXPECT_EQ(Passes({ArithmeticsPass, LiteralsPass, InvalidTypePass}),
+            InstructionPassesForOpcode(spv::Op::OpFAdd));
+}
+
+TEST(ValidatePassTable, OpcodeHandledByPassesFarApart) {
+  EXPECT_EQ(Passes({MemoryPass, LiteralsPass, MeshShadingPass}),
+            InstructionPassesForOpcode(spv::Op::OpVariable));
+}
+
+TEST(ValidatePassTable, TypeOpcodesRunTypePass) {
+  EXPECT_EQ(Passes({TypePass, LiteralsPass}),
+            InstructionPassesForOpcode(spv::Op::OpTypeInt));
+  EXPECT_EQ(Passes({TypePass, LiteralsPass}),
+            InstructionPassesForOpcode(spv::Op::OpTypeForwardPointer));
+}
+
+TEST(ValidatePassTable, ConstantOpcodesRunConstantPass) {
+  EXPECT_EQ(Passes({ConstantPass, LiteralsPass}),
+            InstructionPassesForOpcode(spv::Op::OpConstant));
+  EXPECT_EQ(
+      Passes({ConstantPass, LiteralsPass}),
+      InstructionPassesForOpcode(spv::Op::OpConstantCompositeReplicateEXT));
+  EXPECT_EQ(
+      Passes({ConstantPass, LiteralsPass}),
+      InstructionPassesForOpcode(spv::Op::OpConstantFunctionPointerINTEL));
+}
+
+TEST(ValidatePassTable, ExtendedInstructionRunsExtensionPass) {
+  EXPECT_EQ(Passes({ExtensionPass, LiteralsPass, InvalidTypePass}),
+            InstructionPassesForOpcode(spv::Op::OpExtInst));
+}
+
+TEST(ValidatePassTable, NonUniformOpcodeRunsNonUniformPass) {
+  EXPECT_EQ(Passes({NonUniformPass, LiteralsPass}),
+            InstructionPassesForOpcode(spv::Op::OpGroupNonUniformQuadAllKHR));
+}
+
+TEST(ValidatePassTable, UnhandledOpcodeOnlyRunsLiteralsPass) {
+  EXPECT_EQ(Passes({LiteralsPass}),
+            InstructionPassesForOpcode(spv::Op::OpNop));
+  EXPECT_EQ(Passes({LiteralsPass}),
+            InstructionPassesForOpcode(static_cast<spv::Op>(0xfffe)));
+}
+
+// Every opcode pass, in the order the validator runs them.
+const InstructionPass kAllPasses[] = {
+    MiscPass,         DebugPass,         AnnotationPass,    ExtensionPass,
+    ModeSettingPass,  TypePass,          ConstantPass,      MemoryPass,
+    FunctionPass,     ImagePass,         ConversionPass,    CompositesPass,
+    ArithmeticsPass,  BitwisePass,       LogicalsPass,      ControlFlowPass,
+    DerivativesPass,  AtomicsPass,       PrimitivesPass,    BarriersPass,
+    NonUniformPass,   LiteralsPass,      RayQueryPass,      RayTracingPass,
+    RayReorderNVPass, RayReorderEXTPass, MeshShadingPass,   TensorLayoutPass,
+    TensorPass,       GraphPass,         InvalidTypePass};
+
+bool IsRegistered(InstructionPass pass, spv::Op opcode) {
+  const Passes& passes = InstructionPassesForOpcode(opcode);
+  return std::find(passes.begin(), passes.end(), pass) != passes.end();
+}
+
+// A validation state for a module whose instructions, capabilities and
+// definitions are registered, but which has not been validated. Every
+// diagnostic the passes emit is counted.
+class UnvalidatedState {
+ public:
+  explicit UnvalidatedState(const std::vector<uint32_t>& binary)
+      : binary_(binary),
+        context_(spvContextCreate(SPV_ENV_UNIVERSAL_1_3)),
+        options_(spvValidatorOptionsCreate()) {
+    SetContextMessageConsumer(
+        context_, [this](spv_message_level_t, const char*,
+                         const spv_position_t&, const char* message) {
+          messages_.push_back(message);
+        });
+    state_.reset(new ValidationState_t(context_, options_, binary_.data(),
+                                       binary_.size(), 1));
+    spvBinaryParse(context_, state_.get(), binary_.data(), binary_.size(),
+                   nullptr, AddInstruction, nullptr);
+    for (const Instruction& instruction : state_->ordered_instructions()) {
+      Instruction* inst = const_cast<Instruction*>(&instruction);
+      if (inst->opcode() == spv::Op::OpCapability) {
+        state_->RegisterCapability(inst->GetOperandAs<spv::Capability>(0));
+      }
+      state_->RegisterInstruction(inst);
+    }
+  }
+
+  ~UnvalidatedState() {
+    state_.reset();
+    spvValidatorOptionsDestroy(options_);
+    spvContextDestroy(context_);
+  }
+
+  ValidationState_t& state() { return *state_; }
+  const std::vector<std::string>& messages() const { return messages_; }
+
+ private:
+  static spv_result_t AddInstruction(void* user_data,
+                                     const spv_parsed_instruction_t* inst) {
+    static_cast<ValidationState_t*>(user_data)->AddOrderedInstruction(inst);
+    return SPV_SUCCESS;
+  }
+
+  std::vector<uint32_t> binary_;
+  spv_context context_;
+  spv_validator_options options_;
+  std::unique_ptr<ValidationState_t> state_;
+  std::vector<std::string> messages_;
+};
+
+// A module with instructions from many sections of the specification. The
+// 16-bit constant is only valid with Int16, so ConstantPass reports it.
+const char kParityModule[] = R"(
+OpCapability Shader
+OpCapability StorageBuffer16BitAccess
+OpExtension "SPV_KHR_16bit_storage"
+%ext = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main" %out
+OpExecutionMode %main OriginUpperLeft
+OpName %main "main"
+OpMemberName %struct 0 "a"
+OpDecorate %out Location 0
+OpMemberDecorate %struct 0 Offset 0
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%short = OpTypeInt 16 1
+%float = OpTypeFloat 32
+%v4float = OpTypeVector %float 4
+%struct = OpTypeStruct %float
+%ptr_out = OpTypePointer Output %v4float
+%ptr_fn_float = OpTypePointer Function %float
+%out = OpVariable %ptr_out Output
+%true = OpConstantTrue %bool
+%int_1 = OpConstant %int 1
+%short_1 = OpConstant %short 1
+%float_1 = OpConstant %float 1
+%v4_1 = OpConstantComposite %v4float %float_1 %float_1 %float_1 %float_1
+%null = OpConstantNull %v4float
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%var = OpVariable %ptr_fn_float Function
+OpStore %var %float_1
+%ld = OpLoad %float %var
+%add = OpFAdd %float %ld %float_1
+%iadd = OpIAdd %int %int_1 %int_1
+%cmp = OpSLessThan %bool %iadd %int_1
+%sqrt = OpExtInst %float %ext Sqrt %add
+%vec = OpCompositeConstruct %v4float %sqrt %sqrt %sqrt %sqrt
+%elem = OpCompositeExtract %float %vec 0
+%conv = OpConvertFToS %int %elem
+%and = OpBitwiseAnd %int %conv %int_1
+%sel = OpSelect %float %cmp %elem %float_1
+OpSelectionMerge %merge None
+OpBranchConditional %cmp %then %merge
+%then = OpLabel
+OpBranch %merge
+%merge = OpLabel
+%phi = OpPhi %float %sel %entry %float_1 %then
+%dx = OpDPdx %float %phi
+OpStore %out %vec
+OpReturn
+OpFunctionEnd
+)";
+
+// A pass that is not registered for an opcode must do nothing for it, or the
+// table silently drops a check. Runs each pass on the instructions of a real
+// module whose opcodes it is not registered for.
+TEST(ValidatePassTable, UnregisteredPassesAcceptModuleInstructions) {
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(
+      SpirvTools(SPV_ENV_UNIVERSAL_1_3).Assemble(kParityModule, &binary));
+  UnvalidatedState unvalidated(binary);
+
+  for (const Instruction& inst : unvalidated.state().ordered_instructions()) {
+    for (size_t i = 0; i < std::size(kAllPasses); ++i) {
+      if (IsRegistered(kAllPasses[i], inst.opcode())) continue;
+      EXPECT_EQ(SPV_SUCCESS, kAllPasses[i](unvalidated.state(), &inst))
+          << "pass " << i << " on Op" << spvOpcodeString(inst.opcode());
+    }
+  }
+  EXPECT_THAT(unvalidated.messages(), ::testing::IsEmpty());
+}
+
+// The same for every 16-bit opcode, on an instruction without operands.
+TEST(ValidatePassTable, UnregisteredPassesAcceptEveryOpcode) {
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(
+      SpirvTools(SPV_ENV_UNIVERSAL_1_3).Assemble(kParityModule, &binary));
+  UnvalidatedState unvalidated(binary);
+
+  for (uint32_t opcode = 0; opcode <= 0xffff; ++opcode) {
+    const uint32_t word = (1u << 16) | opcode;
+    spv_parsed_instruction_t parsed = {};
+    parsed.words = &word;
+    parsed.num_words = 1;
+    parsed.opcode = static_cast<uint16_t>(opcode);
+    const Instruction inst(&parsed);
+    for (size_t i = 0; i < std::size(kAllPasses); ++i) {
+      if (IsRegistered(kAllPasses[i], inst.opcode())) continue;
+      ASSERT_EQ(SPV_SUCCESS, kAllPasses[i](unvalidated.state(), &inst))
+          << "pass " << i << " on opcode " << opcode;
+    }
+  }
+  EXPECT_THAT(unvalidated.messages(), ::testing::IsEmpty());
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
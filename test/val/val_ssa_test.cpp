@@ -14,11 +14,14 @@
 
 // Validation tests for SSA
 
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
 
 #include "gmock/gmock.h"
+#include "source/spirv_validator_options.h"
+#include "source/val/function_check_cache.h"
 #include "test/unit_spirv.h"
 #include "test/val/val_fixtures.h"
 
@@ -31,6 +34,86 @@ using ::testing::MatchesRegex;
 
 using ValidateSSA = spvtest::ValidateBase<std::pair<std::string, bool>>;
 
+// Returns a module with |count| functions. Each function computes %x<i> in
+// the then-block of a selection; the functions listed in |bad| also use it in
+// the merge block, which the then-block does not dominate.
+std::string ManyFunctionsModule(int count, const std::set<int>& bad) {
+  std::ostringstream str;
+  str << R"(
+      OpCapability Shader
+      OpCapability Linkage
+      OpMemoryModel Logical GLSL450
+)";
+  for (int i = 0; i < count; ++i) {
+    str << "OpName %x" << i << " \"x" << i << "\"\n";
+  }
+  str << R"(
+%void = OpTypeVoid
+%fn   = OpTypeFunction %void
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+%uint = OpTypeInt 32 0
+%one  = OpConstant %uint 1
+)";
+  for (int i = 0; i < count; ++i) {
+    str << "%f" << i << " = OpFunction %void None %fn\n"
+        << "%entry" << i << " = OpLabel\n"
+        << "OpSelectionMerge %merge" << i << " None\n"
+        << "OpBranchConditional %true %then" << i << " %merge" << i << "\n"
+        << "%then" << i << " = OpLabel\n"
+        << "%x" << i << " = OpIAdd %uint %one %one\n"
+        << "OpBranch %merge" << i << "\n"
+        << "%merge" << i << " = OpLabel\n";
+    if (bad.count(i)) {
+      str << "%y" << i << " = OpIAdd %uint %x" << i << " %one\n";
+    }
+    str << "OpReturn\nOpFunctionEnd\n";
+  }
+  return str.str();
+}
+
+// Returns a module with a single function made of |count| selections in
+// sequence, so that its dominator tree is about 2 * |count| blocks deep. The
+// value computed in the entry block is used in every merge block. If
+// |then_use| is not negative, the last block also uses the value computed in
+// the then-block of selection |then_use|, which does not dominate it.
+std::string SelectionChainModule(int count, int then_use) {
+  std::ostringstream str;
+  str << R"(
+      OpCapability Shader
+      OpCapability Linkage
+      OpMemoryModel Logical GLSL450
+)";
+  for (int i = 0; i < count; ++i) {
+    str << "OpName %y" << i << " \"y" << i << "\"\n";
+  }
+  str << R"(
+%void = OpTypeVoid
+%fn   = OpTypeFunction %void
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+%uint = OpTypeInt 32 0
+%one  = OpConstant %uint 1
+%main = OpFunction %void None %fn
+%entry = OpLabel
+%x    = OpIAdd %uint %one %one
+)";
+  for (int i = 0; i < count; ++i) {
+    str << "OpSelectionMerge %merge" << i << " None\n"
+        << "OpBranchConditional %true %then" << i << " %merge" << i << "\n"
+        << "%then" << i << " = OpLabel\n"
+        << "%y" << i << " = OpIAdd %uint %x %one\n"
+        << "OpBranch %merge" << i << "\n"
+        << "%merge" << i << " = OpLabel\n"
+        << "%z" << i << " = OpIAdd %uint %x %one\n";
+  }
+  if (then_use >= 0) {
+    str << "%bad = OpIAdd %uint %y" << then_use << " %one\n";
+  }
+  str << "OpReturn\nOpFunctionEnd\n";
+  return str.str();
+}
+
 TEST_F(ValidateSSA, Default) {
   char str[] = R"(
      OpCapability Shader
@@ -1443,6 +1526,84 @@ TEST_F(ValidateSSA, TypeStructForwardReference) {
   ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
 }
 
+TEST_F(ValidateSSA, DominateUsageBadSameErrorWithThreads) {
+  CompileSuccessfully(ManyFunctionsModule(300, {150, 250}));
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  const std::string expected = getDiagnosticString();
+  EXPECT_THAT(expected, HasSubstr("[%x150]' defined in block"));
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_EQ(expected, getDiagnosticString());
+}
+
+TEST_F(ValidateSSA, ManyFunctionsGoodWithThreads) {
+  CompileSuccessfully(ManyFunctionsModule(300, {}));
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateSSA, FunctionCheckCacheRechecksChangedFunctions) {
+  FunctionCheckCache cache;
+  getValidatorOptions()->function_check_cache = &cache;
+
+  CompileSuccessfully(ManyFunctionsModule(300, {}));
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+
+  // Only the functions from %f150 on differ from the recorded module.
+  CompileSuccessfully(ManyFunctionsModule(300, {150}));
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[%x150]' defined in block"));
+
+  // The failed validation did not replace the recorded module.
+  CompileSuccessfully(ManyFunctionsModule(300, {}));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateSSA, FunctionCheckCacheChecksUsesFromChangedFunctions) {
+  auto module = [](const std::string& body) {
+    return R"(
+      OpCapability Shader
+      OpCapability Linkage
+      OpMemoryModel Logical GLSL450
+      OpName %x "x"
+%void = OpTypeVoid
+%fn   = OpTypeFunction %void
+%uint = OpTypeInt 32 0
+%one  = OpConstant %uint 1
+%f0   = OpFunction %void None %fn
+%entry0 = OpLabel
+%x    = OpIAdd %uint %one %one
+        OpReturn
+        OpFunctionEnd
+%f1   = OpFunction %void None %fn
+%entry1 = OpLabel
+)" + body + R"(
+        OpReturn
+        OpFunctionEnd
+)";
+  };
+  FunctionCheckCache cache;
+  getValidatorOptions()->function_check_cache = &cache;
+
+  CompileSuccessfully(module(""));
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+
+  // %f0 is unchanged, but the new use of %x in %f1 must still be rejected.
+  CompileSuccessfully(module("%y = OpIAdd %uint %x %one"));
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[%x]'"));
+}
+
+TEST_F(ValidateSSA, DeepSelectionChainDominance) {
+  CompileSuccessfully(SelectionChainModule(2000, -1));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+
+  CompileSuccessfully(SelectionChainModule(2000, 1000));
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[%y1000]' defined in block"));
+}
+
 // TODO(umar): OpGroupMemberDecorate
 
 }  // namespace
@@ -128,6 +128,53 @@ TEST_F(ValidationStateTest, CheckNumInstructions) {
   EXPECT_EQ(size_t(4), vstate_->ordered_instructions().size());
 }
 
+// Tests that instructions refer to the words of the module binary instead of
+// copying them.
+TEST_F(ValidationStateTest, InstructionWordsPointIntoBinary) {
+  std::string spirv = std::string(kHeader) + "%int = OpTypeInt 32 0";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  const uint32_t* begin = binary_->code;
+  const uint32_t* end = binary_->code + binary_->wordCount;
+  for (const auto& inst : vstate_->ordered_instructions()) {
+    EXPECT_LE(begin, inst.words().data());
+    EXPECT_GE(end, inst.words().data() + inst.words().size());
+  }
+  const Instruction& type_int = vstate_->ordered_instructions().back();
+  EXPECT_EQ(spv::Op::OpTypeInt, type_int.opcode());
+  EXPECT_EQ(32u, type_int.GetOperandAs<uint32_t>(1));
+}
+
+// Tests that a module in the other endianness is copied and stays readable.
+TEST_F(ValidationStateTest, InstructionWordsOfByteSwappedBinary) {
+  std::string spirv = std::string(kHeader) + "%int = OpTypeInt 32 0";
+  CompileSuccessfully(spirv);
+  for (size_t i = 0; i < binary_->wordCount; ++i) {
+    const uint32_t w = binary_->code[i];
+    OverwriteAssembledBinary(static_cast<uint32_t>(i),
+                             (w >> 24) | ((w >> 8) & 0xff00u) |
+                                 ((w << 8) & 0xff0000u) | (w << 24));
+  }
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  const uint32_t* begin = binary_->code;
+  const uint32_t* end = binary_->code + binary_->wordCount;
+  for (const auto& inst : vstate_->ordered_instructions()) {
+    const uint32_t* words = inst.words().data();
+    EXPECT_TRUE(words + inst.words().size() <= begin || words >= end);
+  }
+  const Instruction& type_int = vstate_->ordered_instructions().back();
+  EXPECT_EQ(spv::Op::OpTypeInt, type_int.opcode());
+  EXPECT_EQ(32u, type_int.GetOperandAs<uint32_t>(1));
+  EXPECT_EQ(32u, type_int.word(2));
+
+  // The state keeps its own copy, so clearing the binary does not affect it.
+  for (size_t i = 0; i < binary_->wordCount; ++i) {
+    OverwriteAssembledBinary(static_cast<uint32_t>(i), 0);
+  }
+  EXPECT_EQ(spv::Op::OpTypeInt, type_int.opcode());
+  EXPECT_EQ(32u, type_int.word(2));
+}
+
 // Tests that the number of global variables in ValidationState is correct.
 TEST_F(ValidationStateTest, CheckNumGlobalVars) {
   std::string spirv = std::string(kHeader) + R"(
@@ -156,7 +156,7 @@ int main(int, const char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
+  BinaryFile contents;
   if (!ReadBinaryFile(inFile.c_str(), &contents)) return 1;
 
   // If printing to standard output, then spvBinaryToText should
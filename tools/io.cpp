@@ -16,8 +16,11 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <stdarg.h>
 #include <stdlib.h>
 
+#include <string>
+
 #if defined(SPIRV_WINDOWS)
 #include <fcntl.h>
 #include <io.h>
@@ -35,7 +38,37 @@
 #define SET_STDOUT_MODE(mode)
 #endif
 
+#if !defined(SPIRV_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace {
+// Formats an error message from |format| and the arguments that follow it.
+// Appends the message to |errors|, or writes it to standard error if |errors|
+// is nullptr.
+void ReportError(std::string* errors, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const int length = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (length > 0) {
+    std::string message(static_cast<size_t>(length) + 1, '\0');
+    vsnprintf(&message[0], message.size(), format, args);
+    message.resize(static_cast<size_t>(length));
+    if (errors) {
+      errors->append(message);
+    } else {
+      fputs(message.c_str(), stderr);
+    }
+  }
+  va_end(args);
+}
+
 // Appends the contents of the |file| to |data|, assuming each element in the
 // file is of type |T|.
 template <typename T>
@@ -50,16 +83,17 @@ void ReadFile(FILE* file, std::vector<T>* data) {
 }
 
 // Returns true if |file| has encountered an error opening the file or reading
-// from it. If there was an error, writes an error message to standard error.
-bool WasFileCorrectlyRead(FILE* file, const char* filename) {
+// from it. If there was an error, reports it with |ReportError|.
+bool WasFileCorrectlyRead(FILE* file, const char* filename,
+                          std::string* errors) {
   if (file == nullptr) {
-    fprintf(stderr, "error: file does not exist '%s'\n", filename);
+    ReportError(errors, "error: file does not exist '%s'\n", filename);
     return false;
   }
 
   if (ftell(file) == -1L) {
     if (ferror(file)) {
-      fprintf(stderr, "error: error reading file '%s'\n", filename);
+      ReportError(errors, "error: error reading file '%s'\n", filename);
       return false;
     }
   }
@@ -69,12 +103,13 @@ bool WasFileCorrectlyRead(FILE* file, const char* filename) {
 // Ensure the file contained an exact number of elements, whose size is given in
 // |alignment|.
 bool WasFileSizeAligned(const char* filename, size_t read_size,
-                        size_t alignment) {
+                        size_t alignment, std::string* errors) {
   assert(alignment != 1);
   if ((read_size % alignment) != 0) {
-    fprintf(stderr,
-            "error: file size should be a multiple of %zd; file '%s' corrupt\n",
-            alignment, filename);
+    ReportError(
+        errors,
+        "error: file size should be a multiple of %zd; file '%s' corrupt\n",
+        alignment, filename);
     return false;
   }
   return true;
@@ -127,8 +162,8 @@ bool MatchIgnoreCase(const char* token, const char* expect, size_t len) {
 class HexTokenizer {
  public:
   HexTokenizer(const char* filename, const std::vector<char>& stream,
-               std::vector<uint32_t>* data)
-      : filename_(filename), stream_(stream), data_(data) {
+               std::vector<uint32_t>* data, std::string* errors)
+      : filename_(filename), stream_(stream), data_(data), errors_(errors) {
     DetermineMode();
   }
 
@@ -147,9 +182,10 @@ class HexTokenizer {
  private:
   void ParseError(const char* reason) {
     if (!encountered_error_) {
-      fprintf(stderr,
-              "error: hex stream parse error at character %zu: %s in '%s'\n",
-              current_, reason, filename_);
+      ReportError(
+          errors_,
+          "error: hex stream parse error at character %zu: %s in '%s'\n",
+          current_, reason, filename_);
       encountered_error_ = true;
     }
   }
@@ -235,10 +271,10 @@ class HexTokenizer {
     }
 
     if (encountered_error_) {
-      fprintf(stderr,
-              "error: hex format detected, but pattern '%.11s' is not "
-              "recognized '%s'\n",
-              first_token, filename_);
+      ReportError(errors_,
+                  "error: hex format detected, but pattern '%.11s' is not "
+                  "recognized '%s'\n",
+                  first_token, filename_);
     }
 
     // Reset the position to restart parsing with the determined mode.
@@ -342,6 +378,7 @@ class HexTokenizer {
   const char* filename_;
   const std::vector<char>& stream_;
   std::vector<uint32_t>* data_;
+  std::string* errors_;
 
   HexMode mode_ = HexMode::Words;
   size_t current_ = 0;
@@ -349,7 +386,8 @@ class HexTokenizer {
 };
 }  // namespace
 
-bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
+bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data,
+                    std::string* errors) {
   assert(data->empty());
 
   const bool use_file = filename && strcmp("-", filename);
@@ -365,7 +403,7 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
   // processed as such.
   std::vector<char> data_raw;
   ReadFile(fp, &data_raw);
-  bool succeeded = WasFileCorrectlyRead(fp, filename);
+  bool succeeded = WasFileCorrectlyRead(fp, filename, errors);
   if (use_file && fp) fclose(fp);
 
   if (!succeeded) {
@@ -374,11 +412,12 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
 
   if (IsHexStream(data_raw)) {
     // If a hex stream, parse it and fill |data|.
-    HexTokenizer tokenizer(filename, data_raw, data);
+    HexTokenizer tokenizer(filename, data_raw, data, errors);
     succeeded = tokenizer.Parse();
   } else {
     // If not a hex stream, convert it to uint32_t via memcpy.
-    succeeded = WasFileSizeAligned(filename, data_raw.size(), sizeof(uint32_t));
+    succeeded = WasFileSizeAligned(filename, data_raw.size(), sizeof(uint32_t),
+                                   errors);
     if (succeeded) {
       data->resize(data_raw.size() / sizeof(uint32_t), 0);
       memcpy(data->data(), data_raw.data(), data_raw.size());
@@ -388,9 +427,74 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
   return succeeded;
 }
 
+namespace {
+// The first word of a SPIR-V module in host endianness.
+constexpr uint32_t kMagicNumber = 0x07230203;
+
+// Maps the regular file named |filename| into memory if it holds a binary
+// module in host endianness. Returns the mapping and sets |size| to its length
+// in bytes, or returns nullptr if the file is not mapped.
+void* MapBinaryFile(const char* filename, size_t* size) {
+#if defined(SPIRV_WINDOWS)
+  (void)filename;
+  (void)size;
+  return nullptr;
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) return nullptr;
+
+  void* mapping = nullptr;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+      st.st_size % sizeof(uint32_t) == 0) {
+    const size_t length = static_cast<size_t>(st.st_size);
+    mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      mapping = nullptr;
+    } else if (*static_cast<const uint32_t*>(mapping) != kMagicNumber) {
+      munmap(mapping, length);
+      mapping = nullptr;
+    } else {
+      *size = length;
+    }
+  }
+  close(fd);
+  return mapping;
+#endif
+}
+}  // namespace
+
+BinaryFile::~BinaryFile() {
+#if !defined(SPIRV_WINDOWS)
+  if (mapping_) munmap(mapping_, mapping_size_);
+#endif
+}
+
+bool ReadBinaryFile(const char* filename, BinaryFile* file,
+                    std::string* errors) {
+  assert(file->data_ == nullptr && file->mapping_ == nullptr);
+
+  const bool use_file = filename && strcmp("-", filename);
+  if (use_file) {
+    size_t length = 0;
+    if (void* mapping = MapBinaryFile(filename, &length)) {
+      file->mapping_ = mapping;
+      file->mapping_size_ = length;
+      file->data_ = static_cast<const uint32_t*>(mapping);
+      file->size_ = length / sizeof(uint32_t);
+      return true;
+    }
+  }
+
+  if (!ReadBinaryFile(filename, &file->words_, errors)) return false;
+  file->data_ = file->words_.data();
+  file->size_ = file->words_.size();
+  return true;
+}
+
 bool ConvertHexToBinary(const std::vector<char>& stream,
                         std::vector<uint32_t>* data) {
-  HexTokenizer tokenizer("<input string>", stream, data);
+  HexTokenizer tokenizer("<input string>", stream, data, nullptr);
   return tokenizer.Parse();
 }
 
@@ -407,7 +511,7 @@ bool ReadTextFile(const char* filename, std::vector<char>* data) {
   }
 
   ReadFile(fp, data);
-  bool succeeded = WasFileCorrectlyRead(fp, filename);
+  bool succeeded = WasFileCorrectlyRead(fp, filename, nullptr);
   if (use_file && fp) fclose(fp);
   return succeeded;
 }
@@ -453,17 +557,17 @@ class OutputFile {
 
 template <typename T>
 bool WriteFile(const char* filename, const char* mode, const T* data,
-               size_t count) {
+               size_t count, std::string* errors) {
   OutputFile file(filename, mode);
   FILE* fp = file.GetFileHandle();
   if (fp == nullptr) {
-    fprintf(stderr, "error: could not open file '%s'\n", filename);
+    ReportError(errors, "error: could not open file '%s'\n", filename);
     return false;
   }
 
   size_t written = fwrite(data, sizeof(T), count, fp);
   if (count != written) {
-    fprintf(stderr, "error: could not write to file '%s'\n", filename);
+    ReportError(errors, "error: could not write to file '%s'\n", filename);
     return false;
   }
 
@@ -471,6 +575,8 @@ bool WriteFile(const char* filename, const char* mode, const T* data,
 }
 
 template bool WriteFile<uint32_t>(const char* filename, const char* mode,
-                                  const uint32_t* data, size_t count);
+                                  const uint32_t* data, size_t count,
+                                  std::string* errors);
 template bool WriteFile<char>(const char* filename, const char* mode,
-                              const char* data, size_t count);
+                              const char* data, size_t count,
+                              std::string* errors);
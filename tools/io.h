@@ -18,13 +18,15 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
 #include <vector>
 
 // Sets the contents of the file named |filename| in |data|, assuming each
 // element in the file is of type |uint32_t|. The file is opened as a binary
 // file. If |filename| is nullptr or "-", reads from the standard input, but
-// reopened as a binary file. If any error occurs, writes error messages to
-// standard error and returns false.
+// reopened as a binary file. If any error occurs, returns false and appends
+// error messages to |errors|, or writes them to standard error if |errors| is
+// nullptr.
 //
 // If the given input is detected to be in ascii hex, it is converted to binary
 // automatically.  In that case, the shape of the input data is determined based
@@ -39,7 +41,44 @@
 //    big-endian order
 //  * "03[, ]02...": Every following "XY" represents a byte, stored in
 //    little-endian order
-bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data);
+bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data,
+                    std::string* errors = nullptr);
+
+// The words of a SPIR-V binary read by the |ReadBinaryFile| overload below.
+// They are either a read-only memory mapping of the file, or a copy owned by
+// this object.
+class BinaryFile {
+ public:
+  BinaryFile() = default;
+  ~BinaryFile();
+
+  BinaryFile(const BinaryFile&) = delete;
+  BinaryFile& operator=(const BinaryFile&) = delete;
+
+  const uint32_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Returns true if the words are a memory mapping of the file.
+  bool is_mapped() const { return mapping_ != nullptr; }
+
+ private:
+  friend bool ReadBinaryFile(const char* filename, BinaryFile* file,
+                             std::string* errors);
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  std::vector<uint32_t> words_;
+  const uint32_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Same as the above, but maps a regular file holding a binary module in host
+// endianness into memory instead of copying it, where the platform supports
+// it. Hex text, the standard input, and binaries in the other endianness are
+// copied into |file| as the above does. |file| must not have been read into
+// before.
+bool ReadBinaryFile(const char* filename, BinaryFile* file,
+                    std::string* errors = nullptr);
 
 // The hex->binary logic of |ReadBinaryFile| applied to a pre-loaded stream of
 // bytes.  Used by tests to avoid having to call |ReadBinaryFile| with temp
@@ -57,9 +96,10 @@ bool ReadTextFile(const char* filename, std::vector<char>* data);
 // Writes the given |data| into the file named as |filename| using the given
 // |mode|, assuming |data| is an array of |count| elements of type |T|. If
 // |filename| is nullptr or "-", writes to standard output. If any error occurs,
-// returns false and outputs error message to standard error.
+// returns false and appends an error message to |errors|, or writes it to
+// standard error if |errors| is nullptr.
 template <typename T>
 bool WriteFile(const char* filename, const char* mode, const T* data,
-               size_t count);
+               size_t count, std::string* errors = nullptr);
 
 #endif  // TOOLS_IO_H_
@@ -25,6 +25,7 @@
 #include "source/opt/log.h"
 #include "source/spirv_target_env.h"
 #include "source/util/string_utils.h"
+#include "source/util/thread_pool.h"
 #include "spirv-tools/libspirv.hpp"
 #include "spirv-tools/optimizer.hpp"
 #include "tools/io.h"
@@ -102,6 +103,26 @@ Options (in lexicographical order):)",
                and VK_AMD_shader_trinary_minmax with equivalent code using core
                instructions and capabilities.)");
   printf(R"(
+  --analysis-report
+               After the last pass, print to standard error output the analyses
+               each pass invalidated, how many times each analysis was built
+               while the pass ran, and the wall time and page faults the builds
+               took. The report ends with the builds each pass caused by not
+               preserving an analysis, most expensive first. Page faults are
+               only reported on Unix systems, and only when the tools are
+               built with timers enabled.)");
+  printf(R"(
+  --batch <listfile>
+               Optimize many modules in one run. Each non-empty line of
+               <listfile> that does not start with '#' names an input file
+               and an output file, separated by whitespace. The modules are
+               optimized concurrently, one per hardware thread, each with the
+               passes and options given on the command line. Diagnostics are
+               printed per file, in the order of <listfile>, and the exit
+               status is nonzero if any module fails. Cannot be combined with
+               <input> or -o. The output of --print-all and --time-report for
+               different modules may be interleaved.)");
+  printf(R"(
   --before-hlsl-legalization
                Forwards this option to the validator.  See the validator help
                for details.)");
@@ -423,6 +444,17 @@ Options (in lexicographical order):)",
                Change the scope of private variables that are used in a single
                function to that function.)");
   printf(R"(
+  --profile-report=<file>
+               Write a JSON profile of the passes to <file>. For each pass it
+               records the wall and CPU time, how much the peak RSS grew (not
+               the change in memory in use), the page faults, the hardware
+               counters, and the number of functions, blocks and instructions
+               before and after the pass. Memory figures are null unless the
+               tools are built with timers enabled on a Unix system. Hardware
+               counters are null unless the tools are built with
+               SPIRV_ALLOW_PERF_COUNTERS on Linux and the kernel allows them.
+               Cannot be combined with --batch.)");
+  printf(R"(
   --reduce-load-size[=<threshold>]
                Replaces loads of composite objects where not every component is
                used by loads of just the elements that are used.  If the ratio
@@ -555,7 +587,16 @@ Options (in lexicographical order):)",
                systems. This option is the same as -ftime-report in GCC. It
                prints CPU/WALL/USR/SYS time (and RSS if possible), but note that
                USR/SYS time are returned by getrusage() and can have a small
-               error.)");
+               error. When the tools are built with SPIRV_ALLOW_PERF_COUNTERS
+               on Linux, it also prints the cycles, instructions, cache misses
+               and branch misses of each pass, or n/a where the kernel does not
+               allow them.)");
+  printf(R"(
+  --trace-report=<file>
+               Write a timeline of the optimizer run to <file> in the Chrome
+               trace event format, which chrome://tracing and Perfetto can
+               load. It covers parsing, each pass, analysis builds,
+               validation and serialization. Cannot be combined with --batch.)");
   printf(R"(
   --trim-capabilities
                Remove unnecessary capabilities and extensions declared within the
@@ -647,22 +688,31 @@ bool ReadFlagsFromFile(const char* oconfig_flag,
   return true;
 }
 
+// The files that profiling output is written to. A null name means the output
+// is not generated.
+struct ProfileFiles {
+  const char* profile_file = nullptr;  // --profile-report
+  const char* trace_file = nullptr;    // --trace-report
+};
+
 OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
-                     const char** out_file,
+                     const char** out_file, const char** batch_file,
+                     ProfileFiles* profile_files,
                      spvtools::ValidatorOptions* validator_options,
                      spvtools::OptimizerOptions* optimizer_options);
 
 // Parses and handles the -Oconfig flag. |prog_name| contains the name of
 // the spirv-opt binary (used to build a new argv vector for the recursive
 // invocation to ParseFlags). |opt_flag| contains the -Oconfig=FILENAME flag.
-// |optimizer|, |in_file|, |out_file|, |validator_options|, and
-// |optimizer_options| are as in ParseFlags.
+// |optimizer|, |in_file|, |out_file|, |batch_file|, |profile_files|,
+// |validator_options|, and |optimizer_options| are as in ParseFlags.
 //
 // This returns the same OptStatus instance returned by ParseFlags.
 OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
                            spvtools::Optimizer* optimizer, const char** in_file,
-                           const char** out_file,
+                           const char** out_file, const char** batch_file,
+                           ProfileFiles* profile_files,
                            spvtools::ValidatorOptions* validator_options,
                            spvtools::OptimizerOptions* optimizer_options) {
   std::vector<std::string> flags;
@@ -689,7 +739,8 @@ OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
 
   auto ret_val =
       ParseFlags(static_cast<int>(flags.size()), new_argv, optimizer, in_file,
-                 out_file, validator_options, optimizer_options);
+                 out_file, batch_file, profile_files, validator_options,
+                 optimizer_options);
   delete[] new_argv;
   return ret_val;
 }
@@ -739,12 +790,15 @@ std::string CanonicalizeFlag(const char** argv, int argc, int* argi) {
 // Optimizer instance used to optimize the program.
 //
 // On return, this function stores the name of the input program in |in_file|.
-// The name of the output file in |out_file|. The return value indicates whether
+// The name of the output file in |out_file|. The name of the --batch list file,
+// if any, in |batch_file|. The names of the profiling output files, if any, in
+// |profile_files|. The return value indicates whether
 // optimization should continue and a status code indicating an error or
 // success.
 OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
-                     const char** out_file,
+                     const char** out_file, const char** batch_file,
+                     ProfileFiles* profile_files,
                      spvtools::ValidatorOptions* validator_options,
                      spvtools::OptimizerOptions* optimizer_options) {
   std::vector<std::string> pass_flags;
@@ -778,10 +832,24 @@ OptStatus ParseFlags(int argc, const char** argv,
       } else if (0 == strncmp(cur_arg, "-Oconfig=", sizeof("-Oconfig=") - 1)) {
         OptStatus status =
             ParseOconfigFlag(argv[0], cur_arg, optimizer, in_file, out_file,
-                             validator_options, optimizer_options);
+                             batch_file, profile_files, validator_options,
+                             optimizer_options);
         if (status.action != OPT_CONTINUE) {
           return status;
         }
+      } else if (0 == strcmp(cur_arg, "--batch")) {
+        if (!*batch_file && argi + 1 < argc) {
+          *batch_file = argv[++argi];
+        } else {
+          PrintUsage(argv[0]);
+          return {OPT_STOP, 1};
+        }
+      } else if (0 == strncmp(cur_arg, "--batch=", sizeof("--batch=") - 1)) {
+        if (*batch_file) {
+          PrintUsage(argv[0]);
+          return {OPT_STOP, 1};
+        }
+        *batch_file = cur_arg + sizeof("--batch=") - 1;
       } else if (0 == strcmp(cur_arg, "--skip-validation")) {
         optimizer_options->set_run_validator(false);
       } else if (0 == strcmp(cur_arg, "--print-all")) {
@@ -792,6 +860,14 @@ OptStatus ParseFlags(int argc, const char** argv,
         optimizer_options->set_preserve_spec_constants(true);
       } else if (0 == strcmp(cur_arg, "--time-report")) {
         optimizer->SetTimeReport(&std::cerr);
+      } else if (0 == strcmp(cur_arg, "--analysis-report")) {
+        optimizer->SetAnalysisReport(&std::cerr);
+      } else if (0 == strncmp(cur_arg, "--profile-report=",
+                              sizeof("--profile-report=") - 1)) {
+        profile_files->profile_file = cur_arg + sizeof("--profile-report=") - 1;
+      } else if (0 == strncmp(cur_arg, "--trace-report=",
+                              sizeof("--trace-report=") - 1)) {
+        profile_files->trace_file = cur_arg + sizeof("--trace-report=") - 1;
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         validator_options->SetRelaxStructStore(true);
       } else if (0 == strncmp(cur_arg, "--max-id-bound=",
@@ -869,11 +945,138 @@ OptStatus ParseFlags(int argc, const char** argv,
   return {OPT_CONTINUE, 0};
 }
 
+// An input and output file named in a --batch list file.
+struct BatchJob {
+  std::string in_file;
+  std::string out_file;
+};
+
+// Reads the --batch list file named |filename| into |jobs|. Returns false and
+// reports an error if the file cannot be read or a line does not name exactly
+// an input and an output file.
+bool ReadBatchFile(const char* filename, std::vector<BatchJob>* jobs) {
+  std::ifstream input(filename);
+  if (input.fail()) {
+    spvtools::Errorf(opt_diagnostic, nullptr, {},
+                     "Could not read batch list file '%s'", filename);
+    return false;
+  }
+
+  std::string line;
+  for (size_t line_number = 1; std::getline(input, line); ++line_number) {
+    std::istringstream iss(line);
+    BatchJob job;
+    if (!(iss >> job.in_file) || job.in_file[0] == '#') continue;
+    std::string extra;
+    if (!(iss >> job.out_file) || (iss >> extra)) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {},
+                       "%s:%zu: expected an input and an output file",
+                       filename, line_number);
+      return false;
+    }
+    jobs->push_back(std::move(job));
+  }
+  return true;
+}
+
+// Optimizes every module named in the list file |batch_file| concurrently,
+// each with its own Optimizer configured from |argc| and |argv|. Diagnostics
+// are buffered per module and printed in list order once all modules are
+// done. Returns the process exit code.
+int RunBatch(int argc, const char** argv, const char* batch_file) {
+  std::vector<BatchJob> jobs;
+  if (!ReadBatchFile(batch_file, &jobs)) return 1;
+
+  struct BatchResult {
+    bool ok = false;
+    std::ostringstream errors;
+    std::ostringstream messages;
+  };
+  std::vector<BatchResult> results(jobs.size());
+
+  spvtools::utils::ThreadPool pool(
+      spvtools::utils::ThreadPool::HardwareConcurrency());
+  pool.ParallelFor(jobs.size(), [argc, argv, &jobs, &results](size_t i) {
+    const char* in_file = jobs[i].in_file.c_str();
+    BatchResult& result = results[i];
+    auto consumer = [in_file, &result](spv_message_level_t level, const char*,
+                                       const spv_position_t& position,
+                                       const char* message) {
+      switch (level) {
+        case SPV_MSG_FATAL:
+        case SPV_MSG_INTERNAL_ERROR:
+        case SPV_MSG_ERROR:
+          result.errors << "error: " << in_file << ":" << position.index
+                        << ": " << message << std::endl;
+          break;
+        case SPV_MSG_WARNING:
+          result.messages << "warning: " << in_file << ":" << position.index
+                          << ": " << message << std::endl;
+          break;
+        case SPV_MSG_INFO:
+          result.messages << "info: " << in_file << ":" << position.index
+                          << ": " << message << std::endl;
+          break;
+        default:
+          break;
+      }
+    };
+
+    // Passes can only run once, so every module gets its own pipeline. The
+    // flags were already accepted by the caller, so this cannot fail.
+    spvtools::Optimizer optimizer(kDefaultEnvironment);
+    optimizer.SetMessageConsumer(consumer);
+    const char* unused_in_file = nullptr;
+    const char* unused_out_file = nullptr;
+    const char* unused_batch_file = nullptr;
+    ProfileFiles unused_profile_files;
+    spvtools::ValidatorOptions validator_options;
+    spvtools::OptimizerOptions optimizer_options;
+    ParseFlags(argc, argv, &optimizer, &unused_in_file, &unused_out_file,
+               &unused_batch_file, &unused_profile_files, &validator_options,
+               &optimizer_options);
+    optimizer_options.set_validator_options(validator_options);
+
+    // Errors reading and writing files go with the other diagnostics of the
+    // module instead of straight to standard error.
+    std::string io_errors;
+    BinaryFile input;
+    if (!ReadBinaryFile(in_file, &input, &io_errors)) {
+      result.errors << io_errors;
+      return;
+    }
+
+    std::vector<uint32_t> binary;
+    result.ok =
+        optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
+    if (result.ok &&
+        !WriteFile<uint32_t>(jobs[i].out_file.c_str(), "wb", binary.data(),
+                             binary.size(), &io_errors)) {
+      result.errors << io_errors;
+      result.ok = false;
+    }
+  });
+
+  int code = 0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    std::cout << results[i].messages.str();
+    std::cerr << results[i].errors.str();
+    if (!results[i].ok) {
+      std::cerr << "error: " << jobs[i].in_file << ": optimization failed"
+                << std::endl;
+      code = 1;
+    }
+  }
+  return code;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
   const char* in_file = nullptr;
   const char* out_file = nullptr;
+  const char* batch_file = nullptr;
+  ProfileFiles profile_files;
 
   spv_target_env target_env = kDefaultEnvironment;
 
@@ -882,28 +1085,71 @@ int main(int argc, const char** argv) {
 
   spvtools::ValidatorOptions validator_options;
   spvtools::OptimizerOptions optimizer_options;
-  OptStatus status = ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
-                                &validator_options, &optimizer_options);
+  OptStatus status =
+      ParseFlags(argc, argv, &optimizer, &in_file, &out_file, &batch_file,
+                 &profile_files, &validator_options, &optimizer_options);
   optimizer_options.set_validator_options(validator_options);
 
   if (status.action == OPT_STOP) {
     return status.code;
   }
 
+  if (batch_file != nullptr) {
+    if (in_file != nullptr || out_file != nullptr) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      "--batch cannot be combined with an input file or -o");
+      return 1;
+    }
+    if (profile_files.profile_file != nullptr ||
+        profile_files.trace_file != nullptr) {
+      spvtools::Error(
+          opt_diagnostic, nullptr, {},
+          "--batch cannot be combined with --profile-report or --trace-report");
+      return 1;
+    }
+    return RunBatch(argc, argv, batch_file);
+  }
+
+  std::ofstream profile_stream;
+  if (profile_files.profile_file != nullptr) {
+    profile_stream.open(profile_files.profile_file);
+    if (profile_stream.fail()) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {},
+                       "Could not open profile report file '%s'",
+                       profile_files.profile_file);
+      return 1;
+    }
+    optimizer.SetProfileReport(&profile_stream);
+  }
+  std::ofstream trace_stream;
+  if (profile_files.trace_file != nullptr) {
+    trace_stream.open(profile_files.trace_file);
+    if (trace_stream.fail()) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {},
+                       "Could not open trace report file '%s'",
+                       profile_files.trace_file);
+      return 1;
+    }
+    optimizer.SetTraceReport(&trace_stream);
+  }
+
   if (out_file == nullptr) {
     spvtools::Error(opt_diagnostic, nullptr, {}, "-o required");
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile(in_file, &binary)) {
+  BinaryFile input;
+  if (!ReadBinaryFile(in_file, &input)) {
     return 1;
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
+  std::vector<uint32_t> binary;
   bool ok =
-      optimizer.Run(binary.data(), binary.size(), &binary, optimizer_options);
+      optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
+  if (!ok) {
+    // A failed run writes out the module unchanged.
+    binary.assign(input.data(), input.data() + input.size());
+  }
 
   if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
     return 1;
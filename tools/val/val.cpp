@@ -17,10 +17,13 @@
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <system_error>
 #include <vector>
 
 #include "source/spirv_target_env.h"
 #include "source/spirv_validator_options.h"
+#include "source/util/thread_pool.h"
 #include "spirv-tools/libspirv.hpp"
 #include "tools/io.h"
 #include "tools/util/cli_consumer.h"
@@ -76,6 +79,14 @@ Options:
                                    not be allowed by the target environment.
   --before-hlsl-legalization       Allows code patterns that are intended to be
                                    fixed by spirv-opt's legalization passes.
+  --cache-dir                      <directory of validation results>
+                                   Skips modules that already passed validation with the
+                                   same options and target environment, and records the
+                                   ones that pass. The directory is created if needed.
+  --num-threads                    <number of threads used to check functions>
+                                   The reported error does not depend on the number of
+                                   threads. 0 uses one thread per hardware thread.
+                                   The default is 1.
   --version                        Display validator version information.
   --target-env                     {%s}
                                    Use validation rules from the specified environment.
@@ -85,8 +96,9 @@ Options:
 
 bool process_single_file(const char* filename, spv_target_env& target_env,
                          spvtools::ValidatorOptions& options,
+                         spvtools::ValidationCache* cache,
                          bool use_default_msg_consumer) {
-  std::vector<uint32_t> contents;
+  BinaryFile contents;
   if (!ReadBinaryFile(filename, &contents)) return false;
 
   spvtools::SpirvTools tools(target_env);
@@ -127,13 +139,14 @@ bool process_single_file(const char* filename, spv_target_env& target_env,
     tools.SetMessageConsumer(CLIMessageConsumerWithFilename);
   }
 
-  return tools.Validate(contents.data(), contents.size(), options);
+  return tools.Validate(contents.data(), contents.size(), options, cache);
 }
 
 int main(int argc, char** argv) {
   const char* inFile = nullptr;
   spv_target_env target_env = SPV_ENV_UNIVERSAL_1_6;
   spvtools::ValidatorOptions options;
+  const char* cache_dir = nullptr;
   bool continue_processing = true;
   int return_code = 0;
 
@@ -200,6 +213,26 @@ int main(int argc, char** argv) {
           continue_processing = false;
           return_code = 1;
         }
+      } else if (0 == strcmp(cur_arg, "--num-threads")) {
+        uint32_t num_threads = 0;
+        if (argi + 1 < argc && sscanf(argv[++argi], "%u", &num_threads) == 1) {
+          options.SetNumThreads(
+              num_threads == 0
+                  ? spvtools::utils::ThreadPool::HardwareConcurrency()
+                  : num_threads);
+        } else {
+          fprintf(stderr, "error: Missing argument to --num-threads\n");
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--cache-dir")) {
+        if (argi + 1 < argc) {
+          cache_dir = argv[++argi];
+        } else {
+          fprintf(stderr, "error: Missing argument to --cache-dir\n");
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
         options.SetBeforeHlslLegalization(true);
       } else if (0 == strcmp(cur_arg, "--relax-logical-pointer")) {
@@ -252,6 +285,18 @@ int main(int argc, char** argv) {
     return return_code;
   }
 
+  std::unique_ptr<spvtools::ValidationCache> cache;
+  if (cache_dir) {
+    std::error_code error;
+    std::filesystem::create_directories(cache_dir, error);
+    if (error) {
+      fprintf(stderr, "error: Cannot create cache directory %s: %s\n",
+              cache_dir, error.message().c_str());
+      return 1;
+    }
+    cache.reset(new spvtools::DirectoryValidationCache(cache_dir));
+  }
+
   if (inFile &&
       std::filesystem::is_directory(std::filesystem::status(inFile))) {
     const std::filesystem::path dir(inFile);
@@ -274,7 +319,7 @@ int main(int argc, char** argv) {
       const std::string filepath_str(filepath_u8str.begin(),
                                      filepath_u8str.end());
       if (!process_single_file(filepath_str.c_str(), target_env, options,
-                               false)) {
+                               cache.get(), false)) {
         succeed = false;
       }
     }
@@ -282,5 +327,6 @@ int main(int argc, char** argv) {
     return !succeed;
   }
 
-  return !process_single_file(inFile, target_env, options, true);
+  return !process_single_file(inFile, target_env, options, cache.get(),
+                              true);
 }